@@ -61,9 +61,13 @@ include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
 include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
+include $(DRIVER_PATH)/led/tests/rules.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
+include $(QUANTUM_PATH)/matrix/tests/rules.mk
 include $(QUANTUM_PATH)/os_detection/tests/rules.mk
+include $(QUANTUM_PATH)/profiler/tests/rules.mk
+include $(QUANTUM_PATH)/rgb_matrix/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
 include $(QUANTUM_PATH)/logging/print.mk
@@ -85,6 +89,30 @@ $(TEST_OBJ)/$(TEST_OUTPUT)_INC := $($(TEST_OUTPUT)_INC) $(VPATH) $(GTEST_INC)
 $(TEST_OBJ)/$(TEST_OUTPUT)_DEFS := $($(TEST_OUTPUT)_DEFS)
 $(TEST_OBJ)/$(TEST_OUTPUT)_CONFIG := $($(TEST_OUTPUT)_CONFIG)
 
+# Full tests with the same config.h, test.mk and other support files build the same firmware, so everything except
+# their own .cpp files is compiled once into an output shared between them, found by the content of those files.
+# Tests using files from outside their directory keep their own objects. Tests sharing an output must not be built at
+# the same time, see lib/python/qmk/c_tests.py.
+ifneq ($(filter $(FULL_TESTS),$(TEST)),)
+ifneq ($(strip $(TEST_SHARE_OBJECTS)), no)
+ifeq ($(filter ../%,$(SRC))$(findstring ../,$(INTROSPECTION_KEYMAP_C)),)
+TEST_SUPPORT_FILES := $(sort $(filter-out %.cpp,$(wildcard $(TEST_PATH)/*.*)))
+TEST_SHARED := $(TEST_OBJ)/shared_$(word 1,$(shell for f in $(notdir $(TEST_SUPPORT_FILES)); do echo "$$f"; cat "$(TEST_PATH)/$$f"; done | cksum))
+TEST_OWN_SRC := $(filter $(wildcard $(TEST_PATH)/*.cpp),$($(TEST_OUTPUT)_SRC))
+
+$(shell mkdir -p $(TEST_SHARED)/include; for f in $(TEST_SUPPORT_FILES); do cmp -s "$$f" $(TEST_SHARED)/include/$$(basename "$$f") || cp -p "$$f" $(TEST_SHARED)/include/; done)
+
+$(TEST_SHARED)_SRC := $(filter-out $(TEST_OWN_SRC),$($(TEST_OUTPUT)_SRC))
+$(TEST_SHARED)_INC := $(patsubst $(TEST_PATH),$(TEST_SHARED)/include,$($(TEST_OBJ)/$(TEST_OUTPUT)_INC))
+$(TEST_SHARED)_DEFS := $($(TEST_OUTPUT)_DEFS)
+$(TEST_SHARED)_CONFIG := $(TEST_SHARED)/include/config.h
+
+$(TEST_OBJ)/$(TEST_OUTPUT)_SRC := $(TEST_OWN_SRC)
+OUTPUTS += $(TEST_SHARED)
+endif
+endif
+endif
+
 include $(PLATFORM_PATH)/$(PLATFORM_KEY)/platform.mk
 include $(BUILDDEFS_PATH)/common_rules.mk
 
@@ -372,66 +372,88 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3729)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3729-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3731)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3731-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3733)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3733-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3736)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3736-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3737)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3737-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3741)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3741-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3742a)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3742a-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3743a)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3743a-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3745)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3745-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3746a)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3746a-mono.c
     endif
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), snled27351)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led
         SRC += snled27351-mono.c
     endif
@@ -487,66 +509,88 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3729)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3729.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3731)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3731.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3733)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3733.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3736)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3736.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3737)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3737.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3741)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3741.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3742a)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3742a.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3743a)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3743a.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3745)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3745.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), is31fl3746a)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led/issi
         SRC += is31fl3746a.c
     endif
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), snled27351)
         I2C_DRIVER_REQUIRED = yes
+        LED_DIRTY_SPANS_REQUIRED := yes
+        LED_FLUSH_QUEUE_REQUIRED := yes
         COMMON_VPATH += $(DRIVER_PATH)/led
         SRC += snled27351.c
     endif
@@ -566,6 +610,11 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     ifeq ($(strip $(RGB_MATRIX_CUSTOM_USER)), yes)
         OPT_DEFS += -DRGB_MATRIX_CUSTOM_USER
     endif
+
+    ifeq ($(strip $(RGB_MATRIX_ADAPTIVE_PACING)), yes)
+        OPT_DEFS += -DRGB_MATRIX_ADAPTIVE_PACING
+        SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_pacing.c
+    endif
 endif
 
 ifeq ($(strip $(RGB_KEYCODES_ENABLE)), yes)
@@ -955,6 +1004,23 @@ ifeq ($(strip $(APA102_DRIVER_REQUIRED)), yes)
     SRC += apa102.c
 endif
 
+# Keyboards may add these drivers to SRC themselves, rather than through a matrix or backlight feature
+LED_DIRTY_SPANS_DRIVERS := is31fl3729 is31fl3731 is31fl3733 is31fl3736 is31fl3737 is31fl3741 is31fl3742a is31fl3743a is31fl3745 is31fl3746a snled27351
+ifneq ($(filter $(foreach driver,$(LED_DIRTY_SPANS_DRIVERS),%/$(driver).c $(driver).c %/$(driver)-mono.c $(driver)-mono.c),$(SRC) $(QUANTUM_LIB_SRC)),)
+    LED_DIRTY_SPANS_REQUIRED := yes
+endif
+
+ifeq ($(strip $(LED_DIRTY_SPANS_REQUIRED)), yes)
+    COMMON_VPATH += $(DRIVER_PATH)/led
+    SRC += led_dirty_spans.c
+endif
+
+# Only used by the matrix features, when RGB_MATRIX_ASYNC_FLUSH or LED_MATRIX_ASYNC_FLUSH is defined
+ifeq ($(strip $(LED_FLUSH_QUEUE_REQUIRED)), yes)
+    COMMON_VPATH += $(DRIVER_PATH)/led
+    SRC += led_flush_queue.c
+endif
+
 ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_ADC=TRUE
     QUANTUM_LIB_SRC += analog.c
@@ -0,0 +1,78 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "led_dirty_spans.h"
+
+static inline bool is_dirty(const uint8_t *dirty, uint8_t reg) {
+    return dirty[reg / 8] & (1 << (reg % 8));
+}
+
+bool led_dirty_spans_any(const uint8_t *dirty, uint8_t register_count) {
+    for (uint8_t i = 0; i < LED_DIRTY_SPANS_SIZE(register_count); i++) {
+        if (dirty[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool find_span(const led_dirty_spans_t *spans, uint8_t from, uint8_t *start, uint8_t *length) {
+    uint8_t reg = from;
+    while (reg < spans->register_count && !is_dirty(spans->dirty, reg)) {
+        // Skip the registers eight at a time where none changed
+        reg = (reg % 8 == 0 && spans->dirty[reg / 8] == 0) ? reg + 8 : reg + 1;
+    }
+    if (reg >= spans->register_count) {
+        return false;
+    }
+
+    // Extend the burst to the following changed registers, over unchanged ones cheaper to resend than a new burst
+    uint8_t end   = reg + 1;
+    uint8_t limit = spans->register_count - reg < spans->max_length ? spans->register_count : reg + spans->max_length;
+    for (uint8_t next = end; next < limit && next - end <= LED_DIRTY_SPANS_BURST_COST; next++) {
+        if (is_dirty(spans->dirty, next)) {
+            end = next + 1;
+        }
+    }
+
+    *start  = reg;
+    *length = end - reg;
+    return true;
+}
+
+void led_dirty_spans_begin(led_dirty_spans_t *spans, uint8_t *dirty, uint8_t register_count, uint8_t max_length) {
+    spans->dirty          = dirty;
+    spans->register_count = register_count;
+    spans->max_length     = max_length;
+    spans->next           = 0;
+    spans->full           = false;
+
+    uint16_t cost = 0;
+    uint8_t  start, length;
+    for (uint8_t from = 0; find_span(spans, from, &start, &length); from = start + length) {
+        cost += length + LED_DIRTY_SPANS_BURST_COST;
+    }
+
+    uint16_t full_cost = register_count + LED_DIRTY_SPANS_BURST_COST * ((register_count + max_length - 1) / max_length);
+    spans->full        = cost >= full_cost;
+}
+
+bool led_dirty_spans_next(led_dirty_spans_t *spans, uint8_t *start, uint8_t *length) {
+    if (spans->next >= spans->register_count) {
+        return false;
+    }
+
+    if (spans->full) {
+        *start  = spans->next;
+        *length = spans->register_count - spans->next < spans->max_length ? spans->register_count - spans->next : spans->max_length;
+    } else if (!find_span(spans, spans->next, start, length)) {
+        spans->next = spans->register_count;
+        return false;
+    }
+
+    for (uint8_t reg = *start; reg < *start + *length; reg++) {
+        spans->dirty[reg / 8] &= ~(1 << (reg % 8));
+    }
+    spans->next = *start + *length;
+    return true;
+}
@@ -0,0 +1,40 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Tracks which registers of an LED driver's PWM buffer changed since they were last sent, so that only those are
+ * written, as bursts of consecutive registers. A few unchanged registers between two changed ones are sent along when
+ * that costs less than starting another burst, and the whole buffer is sent when that costs no more than the changes.
+ */
+
+#ifndef LED_DIRTY_SPANS_BURST_COST
+// Bus time of starting a burst, in bytes: the start condition, device address, register address and stop condition
+#    define LED_DIRTY_SPANS_BURST_COST 3
+#endif
+
+// Size of the dirty bitmap of a buffer of this many registers
+#define LED_DIRTY_SPANS_SIZE(register_count) (((register_count) + 7) / 8)
+
+typedef struct {
+    uint8_t *dirty;
+    uint8_t  register_count;
+    uint8_t  max_length;
+    uint8_t  next;
+    bool     full;
+} led_dirty_spans_t;
+
+static inline void led_dirty_spans_mark(uint8_t *dirty, uint8_t reg) {
+    dirty[reg / 8] |= 1 << (reg % 8);
+}
+
+bool led_dirty_spans_any(const uint8_t *dirty, uint8_t register_count);
+
+/* Plans the bursts sending the changed registers, of at most `max_length` registers each. */
+void led_dirty_spans_begin(led_dirty_spans_t *spans, uint8_t *dirty, uint8_t register_count, uint8_t max_length);
+
+/* Returns the next burst to send, and marks its registers as sent. Returns false once there are none left. */
+bool led_dirty_spans_next(led_dirty_spans_t *spans, uint8_t *start, uint8_t *length);
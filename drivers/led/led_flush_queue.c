@@ -0,0 +1,76 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "led_flush_queue.h"
+
+#ifdef LED_FLUSH_QUEUE_ENABLE
+
+#    include <string.h>
+
+// Each write is queued as its device address, register address, length, timeout and persistence, followed by its data
+#    define ENTRY_HEADER_SIZE 6
+
+static uint8_t  queue[LED_FLUSH_QUEUE_SIZE];
+static uint16_t queue_head;
+static uint16_t queue_tail;
+static bool     deferred;
+
+static void send_next(void) {
+    const uint8_t *entry   = &queue[queue_head];
+    uint16_t       timeout = entry[3] | (entry[4] << 8);
+
+    led_flush_queue_send_register(entry[0], entry[1], &entry[ENTRY_HEADER_SIZE], entry[2], timeout, entry[5]);
+
+    queue_head += ENTRY_HEADER_SIZE + entry[2];
+    if (queue_head == queue_tail) {
+        queue_head = 0;
+        queue_tail = 0;
+    }
+}
+
+void led_flush_queue_defer(bool defer) {
+    deferred = defer;
+}
+
+i2c_status_t led_flush_queue_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, uint8_t persistence) {
+    if (!deferred || length > UINT8_MAX || length > LED_FLUSH_QUEUE_SIZE - ENTRY_HEADER_SIZE) {
+        led_flush_queue_wait();
+        return led_flush_queue_send_register(devaddr, regaddr, data, length, timeout, persistence);
+    }
+
+    // Out of room, so this frame goes out partly before returning
+    if (queue_tail + ENTRY_HEADER_SIZE + length > LED_FLUSH_QUEUE_SIZE) {
+        led_flush_queue_wait();
+    }
+
+    uint8_t *entry = &queue[queue_tail];
+    entry[0]       = devaddr;
+    entry[1]       = regaddr;
+    entry[2]       = length;
+    entry[3]       = timeout & 0xFF;
+    entry[4]       = timeout >> 8;
+    entry[5]       = persistence;
+    memcpy(&entry[ENTRY_HEADER_SIZE], data, length);
+    queue_tail += ENTRY_HEADER_SIZE + length;
+
+    return I2C_STATUS_SUCCESS;
+}
+
+bool led_flush_queue_busy(void) {
+    return queue_head != queue_tail;
+}
+
+bool led_flush_queue_task(void) {
+    if (led_flush_queue_busy()) {
+        send_next();
+    }
+    return !led_flush_queue_busy();
+}
+
+void led_flush_queue_wait(void) {
+    while (led_flush_queue_busy()) {
+        send_next();
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2c_master.h"
+
+/* Lets an LED driver flush return before its register writes reach the bus. While writes are deferred, each one is
+ * copied into the queue, which keeps the data being sent apart from the driver buffers the next frame is drawn into.
+ * led_flush_queue_task() then sends one write per call, so the keyboard keeps scanning in between. Writes made while
+ * not deferred are sent straight away, once those still queued have been sent.
+ *
+ * A write is attempted up to `persistence` times, or once if that is 0, until it succeeds. Queued writes are retried
+ * as they are sent.
+ */
+
+/* Sends a write straight away. */
+static inline i2c_status_t led_flush_queue_send_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, uint8_t persistence) {
+    i2c_status_t status = i2c_write_register(devaddr, regaddr, data, length, timeout);
+    for (uint8_t i = 1; i < persistence && status != I2C_STATUS_SUCCESS; i++) {
+        status = i2c_write_register(devaddr, regaddr, data, length, timeout);
+    }
+    return status;
+}
+
+#if defined(RGB_MATRIX_ASYNC_FLUSH) || defined(LED_MATRIX_ASYNC_FLUSH)
+#    define LED_FLUSH_QUEUE_ENABLE
+#endif
+
+#ifdef LED_FLUSH_QUEUE_ENABLE
+
+#    ifndef LED_FLUSH_QUEUE_SIZE
+#        define LED_FLUSH_QUEUE_SIZE 1024
+#    endif
+
+void led_flush_queue_defer(bool defer);
+
+i2c_status_t led_flush_queue_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, uint8_t persistence);
+
+bool led_flush_queue_busy(void);
+
+/* Sends the next queued write. Returns true once none are left. */
+bool led_flush_queue_task(void);
+
+/* Sends every queued write. */
+void led_flush_queue_wait(void);
+
+#else
+
+#    define led_flush_queue_write_register led_flush_queue_send_register
+
+#endif
@@ -0,0 +1,62 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Host I2C bus with a single device of I2C_MOCK_PAGES pages of registers, the page being selected by writing to
+ * I2C_MOCK_REG_PAGE as the IS31FL37xx and SNLED27351 drivers do. Every register write is recorded as a transfer.
+ */
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+
+#define I2C_MOCK_PAGES 8
+#define I2C_MOCK_REG_PAGE 0xFD
+#define I2C_MOCK_MAX_TRANSFERS 1024
+
+typedef struct {
+    uint8_t  devaddr;
+    uint8_t  page;
+    uint8_t  reg;
+    uint16_t length;
+} i2c_mock_transfer_t;
+
+extern uint8_t             i2c_mock_registers[I2C_MOCK_PAGES][256];
+extern i2c_mock_transfer_t i2c_mock_transfers[I2C_MOCK_MAX_TRANSFERS];
+extern uint16_t            i2c_mock_transfer_count;
+/* Bytes on the bus: the device address, register address and data of each transfer */
+extern uint32_t i2c_mock_bytes;
+/* Bus time taken by each byte, and the bus time spent so far, to simulate the latency of the transfers */
+extern uint32_t i2c_mock_byte_time_us;
+extern uint32_t i2c_mock_time_us;
+/* Number of the next transfers starting at register i2c_mock_failing_reg to fail, taking up the bus but leaving the
+ * registers as they are */
+extern uint16_t i2c_mock_failures;
+extern uint8_t  i2c_mock_failing_reg;
+
+/* Forgets the recorded transfers, but not the registers */
+void i2c_mock_clear_transfers(void);
+/* Clears the registers, the recorded transfers and the bus time */
+void i2c_mock_reset(void);
@@ -0,0 +1,68 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "i2c_master.h"
+
+#include <string.h>
+
+uint8_t             i2c_mock_registers[I2C_MOCK_PAGES][256];
+i2c_mock_transfer_t i2c_mock_transfers[I2C_MOCK_MAX_TRANSFERS];
+uint16_t            i2c_mock_transfer_count;
+uint32_t            i2c_mock_bytes;
+uint32_t            i2c_mock_byte_time_us;
+uint32_t            i2c_mock_time_us;
+uint16_t            i2c_mock_failures;
+uint8_t             i2c_mock_failing_reg;
+
+static uint8_t page;
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    if (i2c_mock_transfer_count < I2C_MOCK_MAX_TRANSFERS) {
+        i2c_mock_transfers[i2c_mock_transfer_count++] = (i2c_mock_transfer_t){.devaddr = devaddr, .page = page, .reg = regaddr, .length = length};
+    }
+    i2c_mock_bytes += 2 + length;
+    i2c_mock_time_us += (2 + length) * i2c_mock_byte_time_us;
+
+    if (i2c_mock_failures > 0 && regaddr == i2c_mock_failing_reg) {
+        i2c_mock_failures--;
+        return I2C_STATUS_ERROR;
+    }
+
+    for (uint16_t i = 0; i < length && regaddr + i < 256; i++) {
+        if (regaddr + i == I2C_MOCK_REG_PAGE) {
+            page = data[i] % I2C_MOCK_PAGES;
+        } else {
+            i2c_mock_registers[page][regaddr + i] = data[i];
+        }
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+void i2c_mock_clear_transfers(void) {
+    i2c_mock_transfer_count = 0;
+    i2c_mock_bytes          = 0;
+}
+
+void i2c_mock_reset(void) {
+    memset(i2c_mock_registers, 0, sizeof(i2c_mock_registers));
+    page                  = 0;
+    i2c_mock_byte_time_us = 0;
+    i2c_mock_time_us      = 0;
+    i2c_mock_failures     = 0;
+    i2c_mock_clear_transfers();
+}
@@ -0,0 +1,142 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "led_dirty_spans.h"
+}
+
+typedef std::pair<uint8_t, uint8_t> span_t;
+
+class LedDirtySpans : public ::testing::Test {
+   protected:
+    uint8_t dirty[LED_DIRTY_SPANS_SIZE(192)] = {0};
+
+    std::vector<span_t> spans(uint8_t register_count, uint8_t max_length, bool *full = nullptr) {
+        led_dirty_spans_t   iterator;
+        std::vector<span_t> result;
+        uint8_t             start, length;
+
+        led_dirty_spans_begin(&iterator, dirty, register_count, max_length);
+        if (full) {
+            *full = iterator.full;
+        }
+        while (led_dirty_spans_next(&iterator, &start, &length)) {
+            result.push_back({start, length});
+        }
+        return result;
+    }
+};
+
+TEST_F(LedDirtySpans, NothingChanged) {
+    EXPECT_FALSE(led_dirty_spans_any(dirty, 192));
+    EXPECT_TRUE(spans(192, 16).empty());
+}
+
+TEST_F(LedDirtySpans, SingleRegister) {
+    led_dirty_spans_mark(dirty, 37);
+    EXPECT_TRUE(led_dirty_spans_any(dirty, 192));
+
+    EXPECT_EQ(spans(192, 16), (std::vector<span_t>{{37, 1}}));
+    EXPECT_FALSE(led_dirty_spans_any(dirty, 192));
+}
+
+TEST_F(LedDirtySpans, LastRegister) {
+    led_dirty_spans_mark(dirty, 191);
+
+    EXPECT_EQ(spans(192, 16), (std::vector<span_t>{{191, 1}}));
+}
+
+TEST_F(LedDirtySpans, CloseRegistersShareABurst) {
+    led_dirty_spans_mark(dirty, 10);
+    led_dirty_spans_mark(dirty, 10 + LED_DIRTY_SPANS_BURST_COST + 1);
+
+    EXPECT_EQ(spans(192, 16), (std::vector<span_t>{{10, LED_DIRTY_SPANS_BURST_COST + 2}}));
+}
+
+TEST_F(LedDirtySpans, DistantRegistersGetTheirOwnBursts) {
+    led_dirty_spans_mark(dirty, 10);
+    led_dirty_spans_mark(dirty, 10 + LED_DIRTY_SPANS_BURST_COST + 2);
+
+    EXPECT_EQ(spans(192, 16), (std::vector<span_t>{{10, 1}, {10 + LED_DIRTY_SPANS_BURST_COST + 2, 1}}));
+}
+
+TEST_F(LedDirtySpans, BurstsAreSplitAtMaxLength) {
+    for (uint8_t i = 40; i < 60; i++) {
+        led_dirty_spans_mark(dirty, i);
+    }
+
+    EXPECT_EQ(spans(192, 16), (std::vector<span_t>{{40, 16}, {56, 4}}));
+}
+
+TEST_F(LedDirtySpans, EverythingChangedIsSentInFullChunks) {
+    for (uint8_t i = 0; i < 143; i++) {
+        led_dirty_spans_mark(dirty, i);
+    }
+
+    bool                full;
+    std::vector<span_t> expected;
+    for (uint8_t i = 0; i < 143; i += 13) {
+        expected.push_back({i, 13});
+    }
+    EXPECT_EQ(spans(143, 13, &full), expected);
+    EXPECT_TRUE(full);
+    EXPECT_FALSE(led_dirty_spans_any(dirty, 143));
+}
+
+TEST_F(LedDirtySpans, RandomChangesAreAllSent) {
+    std::mt19937 rng(1234);
+
+    for (int round = 0; round < 1000; round++) {
+        uint8_t register_count = std::uniform_int_distribution<int>(1, 192)(rng);
+        uint8_t max_length     = std::uniform_int_distribution<int>(1, 32)(rng);
+        int     percent        = std::uniform_int_distribution<int>(0, 100)(rng);
+        bool    expected[192]  = {false};
+
+        for (uint8_t i = 0; i < register_count; i++) {
+            if (std::uniform_int_distribution<int>(0, 99)(rng) < percent) {
+                led_dirty_spans_mark(dirty, i);
+                expected[i] = true;
+            }
+        }
+
+        bool     sent[192] = {false};
+        int      next      = 0;
+        uint32_t cost      = 0;
+        for (auto span : spans(register_count, max_length)) {
+            ASSERT_GE(span.first, next);
+            ASSERT_GE(span.second, 1);
+            ASSERT_LE(span.second, max_length);
+            ASSERT_LE(span.first + span.second, register_count);
+            for (uint8_t i = span.first; i < span.first + span.second; i++) {
+                sent[i] = true;
+            }
+            next = span.first + span.second;
+            cost += span.second + LED_DIRTY_SPANS_BURST_COST;
+        }
+
+        for (uint8_t i = 0; i < register_count; i++) {
+            ASSERT_TRUE(sent[i] || !expected[i]) << "register " << (int)i << " was not sent";
+        }
+        ASSERT_LE(cost, register_count + LED_DIRTY_SPANS_BURST_COST * ((register_count + max_length - 1) / max_length));
+        ASSERT_FALSE(led_dirty_spans_any(dirty, register_count));
+    }
+}
@@ -0,0 +1,334 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "i2c_master.h"
+#include "led_flush_queue.h"
+
+#if defined(IS31FL3733_I2C_ADDRESS_1)
+#    include "is31fl3733.h"
+#    define DRIVER_I2C_ADDRESS IS31FL3733_I2C_ADDRESS_1
+#    define DRIVER_LED_COUNT IS31FL3733_LED_COUNT
+#    define DRIVER_COMMAND_PWM IS31FL3733_COMMAND_PWM
+#    define DRIVER_I2C_PERSISTENCE IS31FL3733_I2C_PERSISTENCE
+#    define g_driver_leds g_is31fl3733_leds
+#    define driver_init_drivers is31fl3733_init_drivers
+#    define driver_set_color is31fl3733_set_color
+#    define driver_set_color_all is31fl3733_set_color_all
+#    define driver_flush is31fl3733_flush
+typedef is31fl3733_led_t driver_led_t;
+#elif defined(SNLED27351_I2C_ADDRESS_1)
+#    include "snled27351.h"
+#    define DRIVER_I2C_ADDRESS SNLED27351_I2C_ADDRESS_1
+#    define DRIVER_LED_COUNT SNLED27351_LED_COUNT
+#    define DRIVER_COMMAND_PWM SNLED27351_COMMAND_PWM
+#    define DRIVER_I2C_PERSISTENCE SNLED27351_I2C_PERSISTENCE
+#    define g_driver_leds g_snled27351_leds
+#    define driver_init_drivers snled27351_init_drivers
+#    define driver_set_color snled27351_set_color
+#    define driver_set_color_all snled27351_set_color_all
+#    define driver_flush snled27351_flush
+typedef snled27351_led_t driver_led_t;
+#endif
+
+/* Groups of 16 LEDs on three consecutive rows of 16 PWM registers, one row for each color */
+#define LED(i) {0, (i) / 16 * 48 + (i) % 16, (i) / 16 * 48 + 16 + (i) % 16, (i) / 16 * 48 + 32 + (i) % 16}
+#define LEDS_4(i) LED(i), LED(i + 1), LED(i + 2), LED(i + 3)
+#define LEDS_16(i) LEDS_4(i), LEDS_4(i + 4), LEDS_4(i + 8), LEDS_4(i + 12)
+
+const driver_led_t PROGMEM g_driver_leds[DRIVER_LED_COUNT] = {LEDS_16(0), LEDS_16(16), LEDS_16(32), LEDS_16(48)};
+}
+
+#define PWM_REGISTER_COUNT 192
+#define PWM_CHUNK 16
+
+typedef std::pair<uint8_t, uint16_t> burst_t;
+
+class LedDriver : public ::testing::Test {
+   protected:
+    uint8_t colors[DRIVER_LED_COUNT][3] = {{0}};
+
+    void SetUp() override {
+        i2c_mock_reset();
+        driver_init_drivers();
+        driver_set_color_all(0, 0, 0);
+        driver_flush();
+        i2c_mock_clear_transfers();
+    }
+
+    void set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+        driver_set_color(index, red, green, blue);
+        colors[index][0] = red;
+        colors[index][1] = green;
+        colors[index][2] = blue;
+    }
+
+    /* The writes to the PWM registers since the last clear */
+    std::vector<burst_t> pwm_bursts() {
+        std::vector<burst_t> bursts;
+        for (uint16_t i = 0; i < i2c_mock_transfer_count; i++) {
+            const i2c_mock_transfer_t &transfer = i2c_mock_transfers[i];
+            EXPECT_EQ(transfer.devaddr, DRIVER_I2C_ADDRESS << 1);
+            if (transfer.page == DRIVER_COMMAND_PWM && transfer.reg < PWM_REGISTER_COUNT) {
+                bursts.push_back({transfer.reg, transfer.length});
+            }
+        }
+        return bursts;
+    }
+
+    uint32_t pwm_bytes() {
+        uint32_t bytes = 0;
+        for (auto burst : pwm_bursts()) {
+            bytes += 2 + burst.second;
+        }
+        return bytes;
+    }
+
+    void expect_device_matches() {
+        for (int i = 0; i < DRIVER_LED_COUNT; i++) {
+            driver_led_t led = g_driver_leds[i];
+            ASSERT_EQ(i2c_mock_registers[DRIVER_COMMAND_PWM][led.r], colors[i][0]) << "LED " << i;
+            ASSERT_EQ(i2c_mock_registers[DRIVER_COMMAND_PWM][led.g], colors[i][1]) << "LED " << i;
+            ASSERT_EQ(i2c_mock_registers[DRIVER_COMMAND_PWM][led.b], colors[i][2]) << "LED " << i;
+        }
+    }
+};
+
+TEST_F(LedDriver, UnchangedFrameSendsNothing) {
+    driver_set_color_all(0, 0, 0);
+    driver_flush();
+
+    EXPECT_EQ(i2c_mock_transfer_count, 0);
+    EXPECT_EQ(i2c_mock_bytes, 0);
+}
+
+TEST_F(LedDriver, OneLedSendsOnlyItsRegisters) {
+    set_color(21, 10, 20, 30);
+    driver_flush();
+
+    EXPECT_EQ(pwm_bursts(), (std::vector<burst_t>{{53, 1}, {69, 1}, {85, 1}}));
+    EXPECT_EQ(pwm_bytes(), 9);
+    expect_device_matches();
+}
+
+TEST_F(LedDriver, NeighbouringLedsShareBursts) {
+    set_color(4, 1, 2, 3);
+    set_color(5, 1, 2, 3);
+    set_color(7, 1, 2, 3);
+    driver_flush();
+
+    EXPECT_EQ(pwm_bursts(), (std::vector<burst_t>{{4, 4}, {20, 4}, {36, 4}}));
+    expect_device_matches();
+}
+
+TEST_F(LedDriver, EveryLedChangedSendsTheFullPage) {
+    for (int i = 0; i < DRIVER_LED_COUNT; i++) {
+        set_color(i, i, 2 * i, 3 * i + 1);
+    }
+    driver_flush();
+
+    std::vector<burst_t> expected;
+    for (uint8_t i = 0; i < PWM_REGISTER_COUNT; i += PWM_CHUNK) {
+        expected.push_back({i, PWM_CHUNK});
+    }
+    EXPECT_EQ(pwm_bursts(), expected);
+    expect_device_matches();
+}
+
+TEST_F(LedDriver, RandomFramesReachTheDevice) {
+    std::mt19937 rng(42);
+
+    for (int frame = 0; frame < 200; frame++) {
+        int changes = std::uniform_int_distribution<int>(0, DRIVER_LED_COUNT)(rng);
+        for (int i = 0; i < changes; i++) {
+            int index = std::uniform_int_distribution<int>(0, DRIVER_LED_COUNT - 1)(rng);
+            set_color(index, rng(), rng(), rng());
+        }
+
+        i2c_mock_clear_transfers();
+        driver_flush();
+
+        expect_device_matches();
+        ASSERT_LE(pwm_bytes(), PWM_REGISTER_COUNT + 2 * (PWM_REGISTER_COUNT / PWM_CHUNK));
+    }
+}
+
+#if DRIVER_I2C_PERSISTENCE > 2
+TEST_F(LedDriver, FailedWritesAreRetried) {
+    set_color(21, 10, 20, 30);
+    i2c_mock_failures    = 2;
+    i2c_mock_failing_reg = 53;
+    driver_flush();
+
+    EXPECT_EQ(pwm_bursts(), (std::vector<burst_t>{{53, 1}, {53, 1}, {53, 1}, {69, 1}, {85, 1}}));
+    expect_device_matches();
+}
+#else
+TEST_F(LedDriver, FailedWritesAreNotRetried) {
+    set_color(21, 10, 20, 30);
+    i2c_mock_failures    = 1;
+    i2c_mock_failing_reg = 53;
+    driver_flush();
+
+    EXPECT_EQ(pwm_bursts(), (std::vector<burst_t>{{53, 1}, {69, 1}, {85, 1}}));
+    EXPECT_EQ(i2c_mock_registers[DRIVER_COMMAND_PWM][53], 0);
+}
+#endif
+
+#ifdef LED_FLUSH_QUEUE_ENABLE
+
+/* About 400 kHz, with the acknowledge bit */
+#    define BYTE_TIME_US 23
+#    define SCAN_TIME_US 200
+#    define FRAME_TIME_US 16000
+
+static void deferred_flush(void) {
+    led_flush_queue_defer(true);
+    driver_flush();
+    led_flush_queue_defer(false);
+}
+
+TEST_F(LedDriver, DeferredFlushWaitsForTheTask) {
+    set_color(21, 10, 20, 30);
+    deferred_flush();
+
+    EXPECT_EQ(i2c_mock_transfer_count, 0);
+    EXPECT_TRUE(led_flush_queue_busy());
+
+    int tasks = 1;
+    while (!led_flush_queue_task()) {
+        tasks++;
+    }
+    EXPECT_EQ(tasks, i2c_mock_transfer_count);
+    EXPECT_EQ(pwm_bursts(), (std::vector<burst_t>{{53, 1}, {69, 1}, {85, 1}}));
+    expect_device_matches();
+}
+
+#    if DRIVER_I2C_PERSISTENCE > 2
+TEST_F(LedDriver, FailedQueuedWritesAreRetried) {
+    set_color(21, 10, 20, 30);
+    deferred_flush();
+    i2c_mock_failures    = 2;
+    i2c_mock_failing_reg = 53;
+
+    int tasks = 1;
+    while (!led_flush_queue_task()) {
+        tasks++;
+    }
+    // The two retries are made by the task sending the write
+    EXPECT_EQ(tasks, i2c_mock_transfer_count - 2);
+    EXPECT_EQ(pwm_bursts(), (std::vector<burst_t>{{53, 1}, {53, 1}, {53, 1}, {69, 1}, {85, 1}}));
+    expect_device_matches();
+}
+#    endif
+
+TEST_F(LedDriver, QueuedFrameIsKeptApartFromTheNextOne) {
+    set_color(3, 1, 2, 3);
+    deferred_flush();
+    driver_set_color(3, 4, 5, 6);
+
+    led_flush_queue_wait();
+    expect_device_matches();
+
+    set_color(3, 4, 5, 6);
+    deferred_flush();
+    led_flush_queue_wait();
+    expect_device_matches();
+}
+
+TEST_F(LedDriver, DirectWritesFollowTheQueuedOnes) {
+    set_color(3, 1, 2, 3);
+    deferred_flush();
+    set_color(3, 4, 5, 6);
+    driver_flush();
+
+    EXPECT_FALSE(led_flush_queue_busy());
+    expect_device_matches();
+}
+
+TEST_F(LedDriver, OverflowingTheQueueStillSendsEveryFrame) {
+    std::mt19937 rng(7);
+
+    for (int frame = 0; frame < 20; frame++) {
+        for (int i = 0; i < DRIVER_LED_COUNT; i++) {
+            set_color(i, rng(), rng(), rng());
+        }
+        deferred_flush();
+    }
+
+    led_flush_queue_wait();
+    expect_device_matches();
+}
+
+/* Runs a second of a keyboard loop drawing a new frame every FRAME_TIME_US, and returns the longest time between two
+ * matrix scans. */
+static uint32_t longest_scan_interval(bool deferred, uint32_t *frames) {
+    std::mt19937 rng(3);
+    uint32_t     scan_time  = 0;
+    uint32_t     last_scan  = 0;
+    uint32_t     last_frame = 0;
+    uint32_t     longest    = 0;
+
+    i2c_mock_byte_time_us = BYTE_TIME_US;
+    i2c_mock_time_us      = 0;
+    *frames               = 0;
+
+    while (scan_time + i2c_mock_time_us < 1000000) {
+        uint32_t now = scan_time + i2c_mock_time_us;
+        longest      = std::max(longest, now - last_scan);
+        last_scan    = now;
+        scan_time += SCAN_TIME_US;
+
+        if (deferred) {
+            led_flush_queue_task();
+        }
+
+        if (now - last_frame >= FRAME_TIME_US && !led_flush_queue_busy()) {
+            for (int i = 0; i < DRIVER_LED_COUNT; i++) {
+                driver_set_color(i, rng(), rng(), rng());
+            }
+            if (deferred) {
+                deferred_flush();
+            } else {
+                driver_flush();
+            }
+            last_frame = now;
+            (*frames)++;
+        }
+    }
+
+    led_flush_queue_wait();
+    i2c_mock_byte_time_us = 0;
+    return longest;
+}
+
+TEST_F(LedDriver, DeferredFlushKeepsScanIntervalsShort) {
+    uint32_t frames;
+    uint32_t blocking = longest_scan_interval(false, &frames);
+    EXPECT_GE(blocking, SCAN_TIME_US + PWM_REGISTER_COUNT * BYTE_TIME_US);
+
+    uint32_t deferred = longest_scan_interval(true, &frames);
+    EXPECT_LE(deferred, SCAN_TIME_US + (2 + PWM_CHUNK) * BYTE_TIME_US);
+    EXPECT_GE(frames, 1000000 / FRAME_TIME_US - 1);
+}
+
+#endif
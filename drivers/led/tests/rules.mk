@@ -0,0 +1,43 @@
+led_dirty_spans_SRC := \
+	$(DRIVER_PATH)/led/tests/led_dirty_spans_tests.cpp \
+	$(DRIVER_PATH)/led/led_dirty_spans.c
+led_dirty_spans_INC := \
+	$(DRIVER_PATH)/led
+
+led_driver_common_SRC := \
+	$(DRIVER_PATH)/led/tests/led_driver_tests.cpp \
+	$(DRIVER_PATH)/led/tests/i2c_mock.c \
+	$(DRIVER_PATH)/led/led_dirty_spans.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+led_driver_common_INC := \
+	$(DRIVER_PATH)/led/tests \
+	$(DRIVER_PATH)/led/issi \
+	$(DRIVER_PATH)/led
+
+is31fl3733_DEFS := \
+	-DIS31FL3733_I2C_ADDRESS_1=IS31FL3733_I2C_ADDRESS_GND_GND \
+	-DIS31FL3733_LED_COUNT=64 \
+	-DIS31FL3733_I2C_PERSISTENCE=3
+is31fl3733_SRC := \
+	$(led_driver_common_SRC) \
+	$(DRIVER_PATH)/led/issi/is31fl3733.c
+is31fl3733_INC := \
+	$(led_driver_common_INC)
+
+snled27351_DEFS := \
+	-DSNLED27351_I2C_ADDRESS_1=SNLED27351_I2C_ADDRESS_GND \
+	-DSNLED27351_LED_COUNT=64
+snled27351_SRC := \
+	$(led_driver_common_SRC) \
+	$(DRIVER_PATH)/led/snled27351.c
+snled27351_INC := \
+	$(led_driver_common_INC)
+
+is31fl3733_async_DEFS := \
+	$(is31fl3733_DEFS) \
+	-DLED_FLUSH_QUEUE_ENABLE
+is31fl3733_async_SRC := \
+	$(is31fl3733_SRC) \
+	$(DRIVER_PATH)/led/led_flush_queue.c
+is31fl3733_async_INC := \
+	$(led_driver_common_INC)
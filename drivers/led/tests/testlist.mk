@@ -0,0 +1,5 @@
+TEST_LIST += \
+	led_dirty_spans \
+	is31fl3733 \
+	is31fl3733_async \
+	snled27351
@@ -0,0 +1,251 @@
+"""Parallel building and sharded running of the native unit tests.
+
+This mirrors what `make test:<name>` does for each test, but builds the test binaries side by side, runs every binary
+as several gtest shards at once, and merges the XML results of all the shards into a single JUnit report.
+"""
+import math
+import os
+import shutil
+import subprocess
+import time
+import xml.etree.ElementTree as ET
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+BUILD_DIR = Path('.build')
+TEST_OUTPUT_DIR = BUILD_DIR / 'test'
+TEST_RESULTS_DIR = BUILD_DIR / 'test_results'
+
+# A binary is only split into shards once it has this many tests for each of them
+SHARD_MIN_TESTS = 16
+
+
+class CTest:
+    """A test binary, as found by `make list-tests`.
+    """
+    def __init__(self, name, full_tests=()):
+        self.name = name
+        self.full = (Path('tests') / name / 'test.mk').exists()
+        self.path = f'./tests/{name}' if self.full else name
+        self.output = name.replace('/', '_')
+        self.elf = TEST_OUTPUT_DIR / f'{self.output}.elf'
+        self.full_tests = full_tests
+
+    def make_vars(self):
+        """The variables the root Makefile passes to builddefs/build_test.mk for this test.
+        """
+        return [f'TEST={Path(self.path).name}', f'TEST_OUTPUT={self.output}', f'TEST_PATH={self.path}', f'FULL_TESTS={" ".join(self.full_tests)}']
+
+    def support_key(self):
+        """Identifies the objects this test shares with others, see builddefs/build_test.mk.
+
+        Full tests with the same support files (everything but the .cpp files in the test directory) share their
+        firmware objects. Tests using files from the directory above put their objects for those next to the other
+        tests, so all the tests of that directory are kept together. Other tests have none to share.
+        """
+        if not self.full:
+            return self.output
+
+        files = sorted(f for f in Path(self.path).iterdir() if f.is_file() and f.suffix != '.cpp')
+        contents = tuple((f.name, f.read_bytes()) for f in files)
+        if any(b'../' in content for _, content in contents):
+            return str(Path(self.path).parent)
+        return contents
+
+
+def find_tests(make):
+    """Returns every available test, as listed by `make list-tests`.
+    """
+    names = subprocess.run([make, 'list-tests', 'SILENT=true'], capture_output=True, text=True, check=True).stdout.split()
+    full_tests = sorted({Path(name).name for name in names if (Path('tests') / name / 'test.mk').exists()})
+    return [CTest(name, full_tests) for name in sorted(names)]
+
+
+def build_command(make, test, env_vars=(), target=None, jobs=1):
+    """Returns the command building a single test binary.
+    """
+    command = [make, '-r', '-R', '-s', '-f', 'builddefs/build_test.mk']
+    if jobs != 1:
+        command.append('--jobs' if jobs <= 0 else f'--jobs={jobs}')
+    if target:
+        command.append(target)
+    return [*command, *test.make_vars(), 'SILENT=true', *env_vars]
+
+
+def build_tests(make, tests, jobs, env_vars=(), clean=False, on_built=None):
+    """Builds the test binaries, with up to `jobs` builds at the same time.
+
+    Tests sharing objects are built one after the other by the same worker, so that no two builds write the same
+    objects at once. The first test is built on its own, as it also builds googletest, which every test links against.
+
+    Returns a dict of test name to `(returncode, output)`, and calls `on_built(test, returncode, output)` as each build
+    finishes.
+    """
+    groups = {}
+    for test in tests:
+        groups.setdefault(test.support_key(), []).append(test)
+
+    results = {}
+
+    def _build(group, group_jobs=1):
+        for test in group:
+            output = ''
+            returncode = 0
+            if clean:
+                proc = subprocess.run(build_command(make, test, env_vars, 'clean'), stdin=subprocess.DEVNULL, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+                output, returncode = proc.stdout, proc.returncode
+            if returncode == 0:
+                proc = subprocess.run(build_command(make, test, env_vars, jobs=group_jobs), stdin=subprocess.DEVNULL, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+                output, returncode = output + proc.stdout, proc.returncode
+            results[test.name] = (returncode, output)
+            if on_built:
+                on_built(test, returncode, output)
+
+    ordered = sorted(groups.values(), key=len, reverse=True)
+    if ordered:
+        _build(ordered[0][:1], jobs)
+        ordered[0] = ordered[0][1:]
+
+    with ThreadPoolExecutor(max_workers=jobs) as executor:
+        for future in [executor.submit(_build, group) for group in ordered if group]:
+            future.result()
+
+    return results
+
+
+def count_gtest_cases(elf):
+    """Returns the number of tests in a test binary.
+    """
+    listing = subprocess.run([str(elf), '--gtest_list_tests'], stdin=subprocess.DEVNULL, capture_output=True, text=True).stdout
+    return sum(1 for line in listing.splitlines() if line.startswith('  '))
+
+
+class Shard:
+    """One part of a test binary, run as its own process.
+    """
+    def __init__(self, test, index, total):
+        self.test = test
+        self.index = index
+        self.total = total
+        self.xml = TEST_RESULTS_DIR / f'{test.output}.{index}.xml'
+        self.returncode = None
+        self.output = ''
+        self.time = 0.0
+
+    def run(self, extra_env=None):
+        tmpdir = TEST_RESULTS_DIR / 'tmp' / f'{self.test.output}.{self.index}'
+        tmpdir.mkdir(parents=True, exist_ok=True)
+        self.xml.unlink(missing_ok=True)
+
+        env = dict(os.environ, **(extra_env or {}))
+        env['GTEST_TOTAL_SHARDS'] = str(self.total)
+        env['GTEST_SHARD_INDEX'] = str(self.index)
+        env['GTEST_OUTPUT'] = f'xml:{self.xml}'
+        env['TEST_TMPDIR'] = f'{tmpdir}/'
+
+        start = time.monotonic()
+        proc = subprocess.run([str(self.test.elf)], env=env, stdin=subprocess.DEVNULL, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, errors='replace')
+        self.time = time.monotonic() - start
+        self.returncode = proc.returncode
+        self.output = proc.stdout
+        shutil.rmtree(tmpdir, ignore_errors=True)
+        return self
+
+
+def shard_tests(tests, jobs):
+    """Splits the test binaries into shards, so that the larger ones keep all `jobs` workers busy.
+    """
+    sized = [(count_gtest_cases(test.elf), test) for test in tests]
+    shards = []
+    for count, test in sorted(sized, key=lambda sized_test: sized_test[0], reverse=True):
+        total = max(1, min(jobs, math.ceil(count / SHARD_MIN_TESTS)))
+        shards.extend(Shard(test, index, total) for index in range(total))
+    return shards
+
+
+def run_shards(shards, jobs, env=None, on_run=None):
+    """Runs the shards, up to `jobs` of them at the same time, and calls `on_run(shard)` as each finishes.
+    """
+    TEST_RESULTS_DIR.mkdir(parents=True, exist_ok=True)
+
+    def _run(shard):
+        shard.run(env)
+        if on_run:
+            on_run(shard)
+        return shard
+
+    with ThreadPoolExecutor(max_workers=jobs) as executor:
+        return list(executor.map(_run, shards))
+
+
+def _suite_counts(element):
+    counts = {'tests': 0, 'failures': 0, 'errors': 0, 'skipped': 0, 'disabled': 0}
+    for case in element.iter('testcase'):
+        counts['tests'] += 1
+        if case.find('failure') is not None:
+            counts['failures'] += 1
+        elif case.find('error') is not None:
+            counts['errors'] += 1
+        elif case.find('skipped') is not None or case.get('result') == 'skipped':
+            counts['skipped'] += 1
+        if case.get('status') == 'notrun':
+            counts['disabled'] += 1
+    return counts
+
+
+def merge_junit(shards, build_failures=()):
+    """Merges the results of all the shards into a single JUnit document.
+
+    Every gtest suite becomes a `<testsuite>` named `<test>.<suite>`, so the same suite in different binaries is told
+    apart, with the time of each test case. A shard that left no results, because it crashed, and a test that failed
+    to build, are reported as a failed test case carrying its output.
+    """
+    root = ET.Element('testsuites', name='qmk')
+    suites = {}
+    total_time = 0.0
+
+    def _suite(name):
+        if name not in suites:
+            suites[name] = ET.SubElement(root, 'testsuite', name=name)
+            suites[name].set('time', '0')
+        return suites[name]
+
+    def _add_time(suite, seconds):
+        suite.set('time', f'{float(suite.get("time")) + seconds:.3f}')
+
+    def _broken(test, name, message, output, seconds=0.0):
+        suite = _suite(test.name)
+        case = ET.SubElement(suite, 'testcase', name=name, classname=test.name, time=f'{seconds:.3f}')
+        failure = ET.SubElement(case, 'failure', message=message)
+        failure.text = output
+        _add_time(suite, seconds)
+
+    for test, output in build_failures:
+        _broken(test, 'build', 'test failed to build', output)
+
+    for shard in shards:
+        total_time += shard.time
+        try:
+            results = ET.parse(shard.xml).getroot()
+        except (OSError, ET.ParseError):
+            _broken(shard.test, f'shard {shard.index + 1}/{shard.total}', f'test exited with code {shard.returncode} without results', shard.output, shard.time)
+            continue
+
+        for gtest_suite in results.iter('testsuite'):
+            suite = _suite(f'{shard.test.name}.{gtest_suite.get("name")}')
+            for case in gtest_suite.iter('testcase'):
+                case.set('classname', suite.get('name'))
+                suite.append(case)
+            _add_time(suite, float(gtest_suite.get('time', 0)))
+
+        if shard.returncode != 0 and results.find('.//failure') is None:
+            _broken(shard.test, f'shard {shard.index + 1}/{shard.total}', f'test exited with code {shard.returncode}', shard.output, shard.time)
+
+    for suite in root:
+        for key, value in _suite_counts(suite).items():
+            suite.set(key, str(value))
+    for key, value in _suite_counts(root).items():
+        root.set(key, str(value))
+    root.set('time', f'{total_time:.3f}')
+
+    return ET.ElementTree(root)
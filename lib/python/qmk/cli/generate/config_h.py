@@ -1,5 +1,6 @@
 """Used by the make system to generate info_config.h from info.json.
 """
+import re
 from pathlib import Path
 from dotty_dict import dotty
 
@@ -47,6 +48,49 @@ def pin_array(define, pins, postfix):
     return generate_define(f'{define}_PINS{postfix}', f'{{ {pin_array} }}')
 
 
+def pin_port_pad(pin):
+    """Split an MCU pin name into its port and pad, or return None if the pin name is not understood.
+    """
+    match = re.fullmatch(r'GP(\d+)', pin)
+    if match:
+        return 'GP', int(match.group(1))
+
+    match = re.fullmatch(r'([A-Z])(\d+)', pin)
+    if match:
+        return match.group(1), int(match.group(2))
+
+    return None
+
+
+def col_port_runs(pins):
+    """Return the config.h lines that group the column pins by port, so each port is read once per row.
+
+    Columns whose pads are the same distance from their column index share a run, and are moved into place with a single mask and shift.
+    """
+    ports = {}
+    runs = {}
+
+    for col, pin in enumerate(pins):
+        if not pin:
+            continue
+
+        port_pad = pin_port_pad(pin)
+        if not port_pad or port_pad[1] > 31:
+            cli.log.warning(f'Cannot read column pin {pin} as part of a port, falling back to reading one pin at a time.')
+            return ''
+
+        port, pad = port_pad
+        ports.setdefault(port, pin)
+        port_index = list(ports).index(port)
+        runs.setdefault((port_index, col - pad), 0)
+        runs[(port_index, col - pad)] |= 1 << pad
+
+    port_pins = ', '.join(ports.values())
+    port_runs = ', '.join(f'{{ {port_index}, {shift}, 0x{mask:08X} }}' for (port_index, shift), mask in runs.items())
+
+    return '\n'.join([generate_define('MATRIX_COL_PORT_PINS', f'{{ {port_pins} }}'), generate_define('MATRIX_COL_PORT_RUNS', f'{{ {port_runs} }}')])
+
+
 def matrix_pins(matrix_pins, postfix=''):
     """Add the matrix config to the config.h.
     """
@@ -58,6 +102,10 @@ def matrix_pins(matrix_pins, postfix=''):
     if 'cols' in matrix_pins:
         pins.append(pin_array('MATRIX_COL', matrix_pins['cols'], postfix))
 
+        port_runs = col_port_runs(matrix_pins['cols']) if matrix_pins.get('port_reads') and not postfix else None
+        if port_runs:
+            pins.append(port_runs)
+
     if 'rows' in matrix_pins:
         pins.append(pin_array('MATRIX_ROW', matrix_pins['rows'], postfix))
 
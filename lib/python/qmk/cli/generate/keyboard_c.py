@@ -1,5 +1,7 @@
 """Used by the make system to generate keyboard.c from info.json.
 """
+from math import sqrt
+
 from milc import cli
 
 from qmk.info import info_json
@@ -21,6 +23,106 @@ def _gen_led_configs(info_data):
     return lines
 
 
+def _c_div(a, b):
+    """Integer division truncating towards zero, as C does.
+    """
+    quotient = abs(a) // abs(b)
+    return quotient if (a < 0) == (b < 0) else -quotient
+
+
+def _atan2_8(dy, dx):
+    """Python port of atan2_8() from lib/lib8tion/trig8.h
+    """
+    if dy == 0:
+        return 0 if dx >= 0 else 128
+
+    abs_y = abs(dy)
+    if dx >= 0:
+        a = 32 - _c_div(32 * (dx - abs_y), dx + abs_y)
+    else:
+        a = 96 - _c_div(32 * (dx + abs_y), abs_y - dx)
+
+    if dy < 0:
+        a = -a
+    return a & 0xFF
+
+
+def _sqrt16(x):
+    """Python port of sqrt16() from lib/lib8tion/math8.h, including the truncation of its argument to 16 bits
+    """
+    return int(sqrt(x & 0xFFFF))
+
+
+def _gen_led_table_points(info_data, config_type):
+    """Lists the points the LED tables are computed from, which the firmware checks against the points in use
+    """
+    points = [f'{{{led_data.get("x", 0)}, {led_data.get("y", 0)}}}' for led_data in info_data[config_type]['layout']]
+
+    # The firmware falls back to computing the tables' values itself when the points do not match the LEDs in use
+    count = f'{config_type.upper()}_LED_COUNT'
+    lines = []
+    lines.append(f'#if defined({config_type.upper()}_LED_POLAR_TABLE) || defined({config_type.upper()}_LED_DISTANCE_TABLE)')
+    lines.append('static const led_point_t PROGMEM led_table_points[] = {')
+    lines.append(f'  {", ".join(points)}')
+    lines.append('};')
+    lines.append(f'const led_point_t *{config_type}_table_points(void) {{')
+    lines.append(f'  return {count} == {len(points)} ? led_table_points : NULL;')
+    lines.append('}')
+    lines.append('#endif')
+
+    return lines
+
+
+def _gen_led_polar_config(info_data, config_type):
+    """Computes the angle and distance of every LED from the center, as the effect runners would on every frame, for the
+    spiral, pinwheel and out-in effects
+    """
+    center = info_data[config_type].get('center_point', [112, 32])
+    polars = []
+
+    for led_data in info_data[config_type]['layout']:
+        dx, dy = led_data.get('x', 0) - center[0], led_data.get('y', 0) - center[1]
+        polars.append(f'{{{_atan2_8(dy, dx)}, {_sqrt16(dx * dx + dy * dy)}}}')
+
+    count = f'{config_type.upper()}_LED_COUNT'
+    lines = []
+    lines.append(f'#ifdef {config_type.upper()}_LED_POLAR_TABLE')
+    lines.append('static const led_polar_config_t PROGMEM led_polar_config = {')
+    lines.append(f'  {{{center[0]}, {center[1]}}},')
+    lines.append(f'  {{ {", ".join(polars)} }},')
+    lines.append('};')
+    lines.append(f'const led_polar_config_t *{config_type}_polar_config(void) {{')
+    lines.append(f'  return {count} == {len(polars)} ? &led_polar_config : NULL;')
+    lines.append('}')
+    lines.append('#endif')
+
+    return lines
+
+
+def _gen_led_distances(info_data, config_type):
+    """Computes the distance between every pair of LEDs, for the reactive effects
+    """
+    points = [(led_data.get('x', 0), led_data.get('y', 0)) for led_data in info_data[config_type]['layout']]
+    if len(points) < 2:
+        return []
+
+    # Only the pairs with the larger index first are stored, row by row, as the distances are the same both ways
+    count = f'{config_type.upper()}_LED_COUNT'
+    lines = []
+    lines.append(f'#ifdef {config_type.upper()}_LED_DISTANCE_TABLE')
+    lines.append('static const uint8_t PROGMEM led_distances[] = {')
+    for row, (row_x, row_y) in enumerate(points):
+        if row:
+            lines.append(f'  {", ".join(str(_sqrt16((row_x - x) ** 2 + (row_y - y) ** 2)) for x, y in points[:row])},')
+    lines.append('};')
+    lines.append(f'const uint8_t *{config_type}_distance_table(void) {{')
+    lines.append(f'  return {count} == {len(points)} ? led_distances : NULL;')
+    lines.append('}')
+    lines.append('#endif')
+
+    return lines
+
+
 def _gen_led_config(info_data, config_type):
     """Convert info.json content to g_led_config
     """
@@ -56,6 +158,9 @@ def _gen_led_config(info_data, config_type):
     lines.append(f'  {{ {", ".join(pos)} }},')
     lines.append(f'  {{ {", ".join(flags)} }},')
     lines.append('};')
+    lines.extend(_gen_led_table_points(info_data, config_type))
+    lines.extend(_gen_led_polar_config(info_data, config_type))
+    lines.extend(_gen_led_distances(info_data, config_type))
     lines.append('#endif')
     lines.append('')
 
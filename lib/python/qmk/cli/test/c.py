@@ -1,47 +1,78 @@
 import fnmatch
+import os
 import re
-from subprocess import DEVNULL
+import sys
 
 from milc import cli
 
-from qmk.commands import find_make, get_make_parallel_args, build_environment
+from qmk.commands import find_make, build_environment
+from qmk.c_tests import find_tests, build_tests, shard_tests, run_shards, merge_junit
 
 
-@cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
+@cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of tests built and run at the same time; 0 means one per CPU.")
 @cli.argument('-e', '--env', arg_only=True, action='append', default=[], help="Set a variable to be passed to make. May be passed multiple times.")
 @cli.argument('-c', '--clean', arg_only=True, action='store_true', help="Remove object files before compiling.")
 @cli.argument('-l', '--list', arg_only=True, action='store_true', help='List available tests.')
 @cli.argument('-t', '--test', arg_only=True, action='append', default=[], help="Test to run from the available list. Supports wildcard globs. May be passed multiple times.")
+@cli.argument('--junit', arg_only=True, help="Write the results of all tests to this file, as a JUnit report.")
 @cli.subcommand("QMK C Unit Tests.", hidden=False if cli.config.user.developer else True)
 def test_c(cli):
     """Run native unit tests.
     """
-    list_tests = cli.run([find_make(), 'list-tests', 'SILENT=true'])
-    available_tests = sorted(list_tests.stdout.strip().split())
+    make = find_make()
+    available_tests = find_tests(make)
 
     if cli.args.list:
-        return print("\n".join(available_tests))
+        return print("\n".join(test.name for test in available_tests))
 
     # expand any wildcards
-    filtered_tests = set()
-    for test in cli.args.test:
-        regex = re.compile(fnmatch.translate(test))
-        filtered_tests |= set(filter(regex.match, available_tests))
+    tests = available_tests
+    if cli.args.test:
+        tests = []
+        for pattern in cli.args.test:
+            regex = re.compile(fnmatch.translate(pattern))
+            matched = [test for test in available_tests if regex.match(test.name) and test not in tests]
+            if not matched:
+                cli.log.warning(f'Invalid test provided: {pattern}')
+            tests.extend(matched)
 
-    for invalid in filtered_tests - set(available_tests):
-        cli.log.warning(f'Invalid test provided: {invalid}')
+    jobs = cli.config.test_c.parallel
+    if jobs <= 0:
+        jobs = os.cpu_count() or 1
 
-    # convert test names to build targets
-    targets = list(map(lambda x: f'test:{x}', filtered_tests or ['all']))
+    # Add in the environment vars
+    env_vars = [f'{key}={value}' for key, value in build_environment(cli.args.env).items()]
 
-    if cli.args.clean:
-        targets.insert(0, 'clean')
+    def _built(test, returncode, output):
+        if returncode:
+            cli.log.error(f'Building test:{{fg_cyan}}{test.name}{{fg_reset}} {{fg_red}}[ERRORS]{{fg_reset}}')
+            print(output, file=sys.stderr)
+        else:
+            cli.log.info(f'Building test:{{fg_cyan}}{test.name}{{fg_reset}} {{fg_green}}[OK]{{fg_reset}}')
 
-    # Add in the environment vars
-    for key, value in build_environment(cli.args.env).items():
-        targets.append(f'{key}={value}')
+    cli.log.info(f'Compiling {len(tests)} tests, {jobs} at a time')
+    built = build_tests(make, tests, jobs, env_vars, cli.args.clean, _built)
+    build_failures = [(test, built[test.name][1]) for test in tests if built[test.name][0]]
+    failed_builds = {test.name for test, _ in build_failures}
+
+    def _ran(shard):
+        where = f'{shard.test.name}' + (f' (shard {shard.index + 1}/{shard.total})' if shard.total > 1 else '')
+        if shard.returncode:
+            cli.log.error(f'Running test:{{fg_cyan}}{where}{{fg_reset}} {{fg_red}}[FAILED]{{fg_reset}}')
+            print(shard.output, file=sys.stderr)
+        else:
+            cli.log.info(f'Running test:{{fg_cyan}}{where}{{fg_reset}} {{fg_green}}[OK]{{fg_reset}} {shard.time:.2f}s')
+
+    shards = shard_tests([test for test in tests if test.name not in failed_builds], jobs)
+    ran = run_shards(shards, jobs, on_run=_ran)
+
+    report = merge_junit(ran, build_failures)
+    if cli.args.junit:
+        report.write(cli.args.junit, encoding='utf-8', xml_declaration=True)
+        cli.log.info(f'Wrote JUnit report to {{fg_cyan}}{cli.args.junit}')
 
-    command = [find_make(), *get_make_parallel_args(cli.config.test_c.parallel), *targets]
+    results = report.getroot()
+    failed = int(results.get('failures')) + int(results.get('errors'))
+    cli.log.info(f'{results.get("tests")} tests from {len(tests)} binaries, {results.get("skipped")} skipped, {failed} failed')
 
-    cli.log.info('Compiling tests with {fg_cyan}%s', ' '.join(command))
-    return cli.run(command, capture_output=False, stdin=DEVNULL).returncode
+    return 1 if failed else 0
@@ -115,3 +115,132 @@ def list_languages():
         ret.add(file.stem.split('_')[1])
 
     return ret
+
+
+# Modifier bits, as in quantum/modifiers.h
+MOD_BITS = {
+    'MOD_LCTL': 0x01,
+    'MOD_LSFT': 0x02,
+    'MOD_LALT': 0x04,
+    'MOD_LGUI': 0x08,
+    'MOD_RCTL': 0x11,
+    'MOD_RSFT': 0x12,
+    'MOD_RALT': 0x14,
+    'MOD_RGUI': 0x18,
+}
+
+# yapf: disable
+# The single modifier keycode functions from quantum/quantum_keycodes.h, and the modifier each applies
+_MOD_FUNCTIONS = {
+    'LCTL': 'MOD_LCTL', 'C': 'MOD_LCTL',
+    'LSFT': 'MOD_LSFT', 'S': 'MOD_LSFT',
+    'LALT': 'MOD_LALT', 'A': 'MOD_LALT', 'LOPT': 'MOD_LALT',
+    'LGUI': 'MOD_LGUI', 'G': 'MOD_LGUI', 'LCMD': 'MOD_LGUI', 'LWIN': 'MOD_LGUI',
+    'RCTL': 'MOD_RCTL',
+    'RSFT': 'MOD_RSFT',
+    'RALT': 'MOD_RALT', 'ALGR': 'MOD_RALT', 'ROPT': 'MOD_RALT',
+    'RGUI': 'MOD_RGUI', 'RCMD': 'MOD_RGUI', 'RWIN': 'MOD_RGUI',
+}
+
+_MOD_TAP_FUNCTIONS = {
+    'LCTL_T': 'MOD_LCTL', 'CTL_T': 'MOD_LCTL',
+    'LSFT_T': 'MOD_LSFT', 'SFT_T': 'MOD_LSFT',
+    'LALT_T': 'MOD_LALT', 'ALT_T': 'MOD_LALT', 'LOPT_T': 'MOD_LALT', 'OPT_T': 'MOD_LALT',
+    'LGUI_T': 'MOD_LGUI', 'GUI_T': 'MOD_LGUI', 'LCMD_T': 'MOD_LGUI', 'CMD_T': 'MOD_LGUI', 'LWIN_T': 'MOD_LGUI', 'WIN_T': 'MOD_LGUI',
+    'RCTL_T': 'MOD_RCTL',
+    'RSFT_T': 'MOD_RSFT',
+    'RALT_T': 'MOD_RALT', 'ROPT_T': 'MOD_RALT', 'ALGR_T': 'MOD_RALT',
+    'RGUI_T': 'MOD_RGUI', 'RCMD_T': 'MOD_RGUI', 'RWIN_T': 'MOD_RGUI',
+}
+# yapf: enable
+
+# The layer keycode functions, and the range each is in
+_LAYER_FUNCTIONS = {
+    'TO': 'QK_TO',
+    'MO': 'QK_MOMENTARY',
+    'DF': 'QK_DEF_LAYER',
+    'TG': 'QK_TOGGLE_LAYER',
+    'OSL': 'QK_ONE_SHOT_LAYER',
+    'TT': 'QK_LAYER_TAP_TOGGLE',
+}
+
+
+def _split_args(args):
+    """Splits the arguments of a keycode function at the commas that are not within a nested call.
+    """
+    ret = ['']
+    depth = 0
+    for char in args:
+        if char == ',' and depth == 0:
+            ret.append('')
+            continue
+        depth += (char == '(') - (char == ')')
+        ret[-1] += char
+
+    return ret
+
+
+class KeycodeResolver:
+    """Works out the numeric value of keycodes, as the C preprocessor would.
+
+    Knows the names and aliases in the keycode spec, numbers, the single modifier and mod-tap functions, `MT()`, `LT()`
+    and the layer functions. Anything else, such as custom keycodes, resolves to `None`.
+    """
+    def __init__(self, version='latest'):
+        spec = load_spec(version)
+
+        self.ranges = {}
+        for key, value in spec['ranges'].items():
+            self.ranges[value['define']] = int(key.split('/')[0], 16)
+
+        self.names = {}
+        for key, value in spec['keycodes'].items():
+            for name in [value['key']] + value.get('aliases', []):
+                self.names[name] = int(key, 16)
+
+    def _mods(self, mods):
+        bits = 0
+        for mod in mods.split('|'):
+            if mod not in MOD_BITS:
+                return None
+            bits |= MOD_BITS[mod]
+
+        return bits
+
+    def resolve(self, keycode):
+        """Returns the value of a keycode, or `None` if it cannot be worked out.
+        """
+        keycode = ''.join(keycode.split())
+
+        if keycode in self.names:
+            return self.names[keycode]
+
+        try:
+            return int(keycode, 0)
+        except ValueError:
+            pass
+
+        if not keycode.endswith(')') or '(' not in keycode:
+            return None
+
+        function, args = keycode[:-1].split('(', 1)
+        args = _split_args(args)
+
+        if function in _LAYER_FUNCTIONS and len(args) == 1:
+            layer = self.resolve(args[0])
+            return None if layer is None else self.ranges[_LAYER_FUNCTIONS[function]] | (layer & 0x1F)
+
+        if function == 'LT' and len(args) == 2:
+            layer, code = self.resolve(args[0]), self.resolve(args[1])
+            return None if None in (layer, code) else self.ranges['QK_LAYER_TAP'] | ((layer & 0xF) << 8) | (code & 0xFF)
+
+        if (function == 'MT' and len(args) == 2) or (function in _MOD_TAP_FUNCTIONS and len(args) == 1):
+            mods = self._mods(args[0]) if function == 'MT' else MOD_BITS[_MOD_TAP_FUNCTIONS[function]]
+            code = self.resolve(args[-1])
+            return None if None in (mods, code) else self.ranges['QK_MOD_TAP'] | ((mods & 0x1F) << 8) | (code & 0xFF)
+
+        if function in _MOD_FUNCTIONS and len(args) == 1:
+            code = self.resolve(args[0])
+            return None if code is None else (MOD_BITS[_MOD_FUNCTIONS[function]] << 8) | code
+
+        return None
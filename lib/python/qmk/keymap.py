@@ -15,6 +15,7 @@ import qmk.path
 from qmk.constants import QMK_FIRMWARE, QMK_USERSPACE, HAS_QMK_USERSPACE
 from qmk.keyboard import find_keyboard_from_dir, keyboard_folder, keyboard_aliases
 from qmk.errors import CppError
+from qmk.keycodes import KeycodeResolver
 from qmk.info import info_json
 
 # The `keymap.c` template to use when a keyboard doesn't have its own
@@ -39,7 +40,7 @@ __ENCODER_MAP_GOES_HERE__
 };
 #endif // defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE)
 
-__MACRO_OUTPUT_GOES_HERE__
+__COMBOS_GO_HERE____MACRO_OUTPUT_GOES_HERE__
 """
 
 
@@ -125,6 +126,85 @@ def _generate_macros_function(keymap_json):
     return macro_txt
 
 
+def _generate_combos(keymap_json):
+    """Generates the combo definitions, along with an index of the combos each keycode is part of.
+
+    The index lets the combo engine go straight to the combos containing a key, and where the key is within each of them,
+    instead of searching every combo on each key event.
+    """
+    combos = keymap_json['combos']
+
+    combo_txt = ['#if defined(COMBO_ENABLE)']
+    for i, combo in enumerate(combos):
+        keys = ', '.join(map(_strip_any, combo['keys']))
+        combo_txt.append(f'const uint16_t PROGMEM combo_keys_{i}[] = {{{keys}, COMBO_END}};')
+    combo_txt.append('')
+
+    combo_txt.append('combo_t key_combos[] = {')
+    for i, combo in enumerate(combos):
+        combo_txt.append(f'    COMBO(combo_keys_{i}, {_strip_any(combo["result"])}),')
+    combo_txt.append('};')
+    combo_txt.append('')
+
+    combo_txt.extend(_generate_combo_index(combos))
+
+    if any('term' in combo for combo in combos):
+        terms = ', '.join(str(combo.get('term', 'COMBO_TERM')) for combo in combos)
+        combo_txt.append('')
+        combo_txt.append('#    if !defined(COMBO_TERM_PER_COMBO)')
+        combo_txt.append('#        error "Combos with their own term require COMBO_TERM_PER_COMBO to be defined"')
+        combo_txt.append('#    endif')
+        combo_txt.append('#    define COMBO_GENERATED_TERMS')
+        combo_txt.append(f'const uint16_t PROGMEM combo_terms[] = {{{terms}}};')
+
+    combo_txt.append('#endif // defined(COMBO_ENABLE)')
+    combo_txt.append('')
+    combo_txt.append('')
+    return combo_txt
+
+
+def _generate_combo_index(combos):
+    """Generates the index of the combos each keycode is part of, sorted by keycode so that the engine can binary search it.
+
+    Different spellings of one keycode share an entry. If a key cannot be resolved to its value, no index is generated,
+    and the engine indexes the combos at runtime instead.
+    """
+    resolver = KeycodeResolver()
+
+    keycodes = {}
+    names = {}
+    for i, combo in enumerate(combos):
+        keys = []
+        for key in combo['keys']:
+            code = resolver.resolve(_strip_any(key))
+            if code is None:
+                return [f'// {_strip_any(key)} is not a known keycode, so the combos are indexed at runtime']
+            names.setdefault(code, ''.join(_strip_any(key).split()))
+            keys.append(code)
+
+        for code in dict.fromkeys(keys):
+            # The engine uses the last position of a key that appears more than once within a combo
+            key_index = len(keys) - 1 - keys[::-1].index(code)
+            keycodes.setdefault(code, []).append(f'{{{i}, {key_index}, {len(keys)}}}')
+
+    if not keycodes:
+        return []
+
+    keycodes = dict(sorted(keycodes.items()))
+    offsets = [0]
+    for refs in keycodes.values():
+        offsets.append(offsets[-1] + len(refs))
+
+    index_txt = ['#    define COMBO_GENERATED_INDEX']
+    index_txt.append(f'const uint16_t PROGMEM combo_index_keycodes[] = {{{", ".join(f"0x{code:04X}" for code in keycodes)}}};')
+    index_txt.append(f'const uint16_t PROGMEM combo_index_offsets[] = {{{", ".join(map(str, offsets))}}};')
+    index_txt.append('const combo_key_ref_t PROGMEM combo_index_refs[] = {')
+    for code, refs in keycodes.items():
+        index_txt.append(f'    {", ".join(refs)}, // {names[code]}')
+    index_txt.append('};')
+    return index_txt
+
+
 def _strip_any(keycode):
     """Remove ANY() from a keycode.
     """
@@ -242,6 +322,9 @@ def generate_json(keymap, keyboard, layout, layers, macros=None):
 
         macros
             A sequence of strings containing macros to implement for this keyboard.
+
+        combos
+            An array of combos, each with the `keys` that trigger it, the `result` keycode, and an optional `term`.
     """
     new_keymap = {'keyboard': keyboard}
     new_keymap['keymap'] = keymap
@@ -281,6 +364,12 @@ def generate_c(keymap_json):
         encodermap = '\n'.join(encoder_txt)
     new_keymap = new_keymap.replace('__ENCODER_MAP_GOES_HERE__', encodermap)
 
+    combos = ''
+    if 'combos' in keymap_json and keymap_json['combos'] is not None:
+        combo_txt = _generate_combos(keymap_json)
+        combos = '\n'.join(combo_txt)
+    new_keymap = new_keymap.replace('__COMBOS_GO_HERE__', combos)
+
     macros = ''
     if 'macros' in keymap_json and keymap_json['macros'] is not None:
         macro_txt = _generate_macros_function(keymap_json)
@@ -1,4 +1,5 @@
 import platform
+from pathlib import Path
 from subprocess import DEVNULL
 
 from milc import cli
@@ -176,6 +177,32 @@ def test_json2c_macros():
     assert 'SEND_STRING("Hello, World!"SS_TAP(X_ENTER));' in result.stdout
 
 
+def test_json2c_combos():
+    result = check_subcommand("json2c", 'keyboards/handwired/pytest/basic/keymaps/combos/keymap.json')
+    check_returncode(result)
+    assert 'const uint16_t PROGMEM combo_keys_1[] = {KC_B, KC_C, KC_B, COMBO_END};' in result.stdout
+    assert 'COMBO(combo_keys_0, KC_ESC),' in result.stdout
+    assert 'const uint16_t PROGMEM combo_index_keycodes[] = {0x0004, 0x0005, 0x0006, 0x0028, 0x4104};' in result.stdout
+    assert 'const uint16_t PROGMEM combo_index_offsets[] = {0, 1, 3, 5, 7, 8};' in result.stdout
+    assert '{0, 1, 2}, {1, 2, 3}, // KC_B' in result.stdout
+    assert '{2, 0, 2}, {3, 0, 2}, // KC_ENT' in result.stdout
+    assert '{3, 1, 2}, // LT(1,KC_A)' in result.stdout
+    assert 'const uint16_t PROGMEM combo_terms[] = {COMBO_TERM, 100, COMBO_TERM, COMBO_TERM};' in result.stdout
+    assert 'get_combo_term' not in result.stdout
+
+
+def test_json2c_combos_fixture():
+    """The combo index test build uses a copy of what json2c generates for its keymap.json, which has to stay in step.
+    """
+    def combo_lines(text):
+        lines = text.splitlines()
+        return lines[lines.index('#if defined(COMBO_ENABLE)'):lines.index('#endif // defined(COMBO_ENABLE)') + 1]
+
+    result = check_subcommand("json2c", 'tests/combo_index/combo_generated/keymap.json')
+    check_returncode(result)
+    assert combo_lines(result.stdout) == combo_lines(Path('tests/combo_index/combo_generated/test_combos.c').read_text())
+
+
 def test_json2c_stdin():
     result = check_subcommand_stdin('keyboards/handwired/pytest/basic/keymaps/default_json/keymap.json', 'json2c', '-')
     check_returncode(result)
@@ -312,6 +339,14 @@ def test_generate_config_h():
     assert '#    define MATRIX_ROW_PINS { F5 }' in result.stdout
 
 
+def test_generate_config_h_port_reads():
+    result = check_subcommand('generate-config-h', 'keyboards/handwired/pytest/basic/keymaps/port_reads/keymap.json')
+    check_returncode(result)
+    assert '#define MATRIX_COL_PINS { F4, F5, B0, NO_PIN, F7, B2 }' in result.stdout
+    assert '#define MATRIX_COL_PORT_PINS { F4, B0 }' in result.stdout
+    assert '#define MATRIX_COL_PORT_RUNS { { 0, -4, 0x00000030 }, { 1, 2, 0x00000001 }, { 0, -3, 0x00000080 }, { 1, 3, 0x00000004 } }' in result.stdout
+
+
 def test_generate_rules_mk():
     result = check_subcommand('generate-rules-mk', '-kb', 'handwired/pytest/basic')
     check_returncode(result)
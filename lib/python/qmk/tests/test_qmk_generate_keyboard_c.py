@@ -0,0 +1,75 @@
+from qmk.cli.generate.keyboard_c import _gen_led_table_points, _gen_led_polar_config, _gen_led_distances, _atan2_8, _sqrt16
+
+
+def _led_tables_info():
+    """An LED layout with the corners of the coordinate space, the center and the points straight across from it, and a
+    spread of points all around it.
+    """
+    points = [(0, 0), (255, 0), (0, 255), (255, 255), (112, 32), (112, 0), (112, 64), (0, 32), (224, 32), (113, 33), (111, 31)]
+    points += [((i * 97 + 13) % 256, (i * 61 + 7) % 256) for i in range(40)]
+    return {'rgb_matrix': {'center_point': [112, 32], 'layout': [{'x': x, 'y': y} for x, y in points]}}
+
+
+# The same values are expected of lib8tion by the led_tables unit test, in quantum/rgb_matrix/tests/led_tables_tests.cpp,
+# so that the generated tables match what the firmware computes without them
+def test_atan2_8():
+    assert _atan2_8(0, 1) == 0
+    assert _atan2_8(0, -1) == 128
+    assert _atan2_8(1, 0) == 64
+    assert _atan2_8(-1, 0) == 192
+    assert _atan2_8(1, 1) == 32
+    assert _atan2_8(-1, -1) == 160
+    # C division truncates towards zero
+    assert _atan2_8(1, 2) == 22
+    assert _atan2_8(1, -2) == 106
+    assert _atan2_8(32, 112) == 15
+    assert _atan2_8(-32, -112) == 143
+    assert _atan2_8(223, 143) == 38
+    assert _atan2_8(-32, 143) == 244
+
+
+def test_sqrt16():
+    assert _sqrt16(0) == 0
+    assert _sqrt16(1) == 1
+    assert _sqrt16(24) == 4
+    assert _sqrt16(25) == 5
+    assert _sqrt16(13568) == 116
+    assert _sqrt16(65535) == 255
+    # The C argument is 16 bits wide
+    assert _sqrt16(65536 + 25) == 5
+
+
+def test_gen_led_polar_config():
+    info_data = {'led_matrix': {'center_point': [112, 32], 'layout': [{'x': 112, 'y': 32}, {'x': 112, 'y': 0}, {'x': 0, 'y': 32}, {'x': 224, 'y': 64}]}}
+    lines = _gen_led_polar_config(info_data, 'led_matrix')
+
+    # Only built for the effects that use it
+    assert lines[0] == '#ifdef LED_MATRIX_LED_POLAR_TABLE'
+    assert lines[-1] == '#endif'
+    assert lines[2] == '  {112, 32},'
+    assert lines[3] == '  { {0, 0}, {192, 32}, {128, 112}, {15, 116} },'
+    assert 'return LED_MATRIX_LED_COUNT == 4 ? &led_polar_config : NULL;' in lines[-3]
+
+
+def test_gen_led_table_points():
+    info_data = {'rgb_matrix': {'layout': [{'x': 1, 'y': 2}, {'x': 3, 'y': 4}]}}
+    lines = _gen_led_table_points(info_data, 'rgb_matrix')
+
+    # Needed by either table
+    assert lines[0] == '#if defined(RGB_MATRIX_LED_POLAR_TABLE) || defined(RGB_MATRIX_LED_DISTANCE_TABLE)'
+    assert lines[-1] == '#endif'
+    assert lines[2] == '  {1, 2}, {3, 4}'
+
+
+def test_gen_led_distances_layout():
+    info_data = _led_tables_info()
+    points = [(led['x'], led['y']) for led in info_data['rgb_matrix']['layout']]
+    rows = [line.strip().rstrip(',') for line in _gen_led_distances(info_data, 'rgb_matrix')[2:len(points) + 1]]
+    table = [int(distance) for row in rows for distance in row.split(', ')]
+
+    # Every pair is found where the firmware looks it up, at row * (row - 1) / 2 + col with row the larger index
+    assert len(table) == len(points) * (len(points) - 1) // 2
+    for row, (row_x, row_y) in enumerate(points):
+        for col, (x, y) in enumerate(points[:row]):
+            assert table[row * (row - 1) // 2 + col] == _sqrt16((row_x - x)**2 + (row_y - y)**2)
+
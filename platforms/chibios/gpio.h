@@ -41,5 +41,6 @@ typedef ioline_t pin_t;
     } while (0)
 
 #define gpio_read_pin(pin) palReadLine(pin)
+#define gpio_read_port(pin) palReadPort(PAL_PORT(pin))
 
 #define gpio_toggle_pin(pin) palToggleLine(pin)
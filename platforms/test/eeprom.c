@@ -18,78 +18,110 @@
 
 static uint8_t buffer[TOTAL_EEPROM_BYTE_COUNT];
 
-uint8_t eeprom_read_byte(const uint8_t *addr) {
+// Transaction counters, so that tests can check how the EEPROM is accessed
+uint32_t eeprom_test_read_transactions  = 0;
+uint32_t eeprom_test_write_transactions = 0;
+uint32_t eeprom_test_bytes_written      = 0;
+
+void eeprom_test_reset_counters(void) {
+    eeprom_test_read_transactions  = 0;
+    eeprom_test_write_transactions = 0;
+    eeprom_test_bytes_written      = 0;
+}
+
+static uint8_t buffer_read(const uint8_t *addr) {
     uintptr_t offset = (uintptr_t)addr;
     return buffer[offset];
 }
 
-void eeprom_write_byte(uint8_t *addr, uint8_t value) {
+static void buffer_write(uint8_t *addr, uint8_t value) {
     uintptr_t offset = (uintptr_t)addr;
     buffer[offset]   = value;
+    eeprom_test_bytes_written++;
+}
+
+uint8_t eeprom_read_byte(const uint8_t *addr) {
+    eeprom_test_read_transactions++;
+    return buffer_read(addr);
+}
+
+void eeprom_write_byte(uint8_t *addr, uint8_t value) {
+    eeprom_test_write_transactions++;
+    buffer_write(addr, value);
 }
 
 uint16_t eeprom_read_word(const uint16_t *addr) {
+    eeprom_test_read_transactions++;
     const uint8_t *p = (const uint8_t *)addr;
-    return eeprom_read_byte(p) | (eeprom_read_byte(p + 1) << 8);
+    return buffer_read(p) | (buffer_read(p + 1) << 8);
 }
 
 uint32_t eeprom_read_dword(const uint32_t *addr) {
+    eeprom_test_read_transactions++;
     const uint8_t *p = (const uint8_t *)addr;
-    return eeprom_read_byte(p) | (eeprom_read_byte(p + 1) << 8) | (eeprom_read_byte(p + 2) << 16) | (eeprom_read_byte(p + 3) << 24);
+    return buffer_read(p) | (buffer_read(p + 1) << 8) | (buffer_read(p + 2) << 16) | (buffer_read(p + 3) << 24);
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_test_read_transactions++;
     const uint8_t *p    = (const uint8_t *)addr;
     uint8_t *      dest = (uint8_t *)buf;
     while (len--) {
-        *dest++ = eeprom_read_byte(p++);
+        *dest++ = buffer_read(p++);
     }
 }
 
 void eeprom_write_word(uint16_t *addr, uint16_t value) {
+    eeprom_test_write_transactions++;
     uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p, value >> 8);
+    buffer_write(p++, value);
+    buffer_write(p, value >> 8);
 }
 
 void eeprom_write_dword(uint32_t *addr, uint32_t value) {
+    eeprom_test_write_transactions++;
     uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p++, value >> 8);
-    eeprom_write_byte(p++, value >> 16);
-    eeprom_write_byte(p, value >> 24);
+    buffer_write(p++, value);
+    buffer_write(p++, value >> 8);
+    buffer_write(p++, value >> 16);
+    buffer_write(p, value >> 24);
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    eeprom_test_write_transactions++;
     uint8_t *      p   = (uint8_t *)addr;
     const uint8_t *src = (const uint8_t *)buf;
     while (len--) {
-        eeprom_write_byte(p++, *src++);
+        buffer_write(p++, *src++);
     }
 }
 
 void eeprom_update_byte(uint8_t *addr, uint8_t value) {
-    eeprom_write_byte(addr, value);
+    eeprom_test_write_transactions++;
+    buffer_write(addr, value);
 }
 
 void eeprom_update_word(uint16_t *addr, uint16_t value) {
+    eeprom_test_write_transactions++;
     uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p, value >> 8);
+    buffer_write(p++, value);
+    buffer_write(p, value >> 8);
 }
 
 void eeprom_update_dword(uint32_t *addr, uint32_t value) {
+    eeprom_test_write_transactions++;
     uint8_t *p = (uint8_t *)addr;
-    eeprom_write_byte(p++, value);
-    eeprom_write_byte(p++, value >> 8);
-    eeprom_write_byte(p++, value >> 16);
-    eeprom_write_byte(p, value >> 24);
+    buffer_write(p++, value);
+    buffer_write(p++, value >> 8);
+    buffer_write(p++, value >> 16);
+    buffer_write(p, value >> 24);
 }
 
 void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    eeprom_test_write_transactions++;
     uint8_t *      p   = (uint8_t *)addr;
     const uint8_t *src = (const uint8_t *)buf;
     while (len--) {
-        eeprom_write_byte(p++, *src++);
+        buffer_write(p++, *src++);
     }
 }
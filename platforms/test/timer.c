@@ -16,10 +16,14 @@
 
 #include "timer.h"
 #include <stdatomic.h>
+#include <stdbool.h>
+#include <time.h>
 
 static atomic_uint_least32_t current_time      = 0;
 static atomic_uint_least32_t async_tick_amount = 0;
 static atomic_uint_least32_t access_counter    = 0;
+static atomic_uint_least32_t simulated_cycles  = 0;
+static atomic_bool           cycles_simulated  = false;
 
 void simulate_async_tick(uint32_t t) {
     async_tick_amount = t;
@@ -81,3 +85,28 @@ void advance_time(uint32_t ms) {
 void wait_ms(uint32_t ms) {
     advance_time(ms);
 }
+
+void set_cycles(uint32_t cycles) {
+    simulated_cycles = cycles;
+    cycles_simulated = true;
+}
+
+void advance_cycles(uint32_t cycles) {
+    simulated_cycles += cycles;
+    cycles_simulated = true;
+}
+
+void use_host_cycles(void) {
+    cycles_simulated = false;
+}
+
+uint32_t profiler_read_cycles(void) {
+    if (cycles_simulated) {
+        return simulated_cycles;
+    }
+
+    // Host nanoseconds stand in for the MCU cycle counter
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
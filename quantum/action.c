@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keycode_config.h"
 #include "debug.h"
 #include "quantum.h"
+#include "scan_stage.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -71,6 +72,12 @@ __attribute__((weak)) bool get_retro_tapping(uint16_t keycode, keyrecord_t *reco
  * FIXME: Needs documentation.
  */
 void action_exec(keyevent_t event) {
+    SCAN_STAGE_ENTER(SCAN_STAGE_ACTION_EXEC);
+
+#ifdef KEYSTROKE_TRACE_ENABLE
+    keystroke_trace_record(event);
+#endif
+
     if (IS_EVENT(event)) {
         ac_dprintf("\n---- action_exec: start -----\n");
         ac_dprintf("EVENT: ");
@@ -95,6 +102,11 @@ void action_exec(keyevent_t event) {
 
     keyrecord_t record = {.event = event};
 
+    if (IS_EVENT(record.event)) {
+        // Any event may start or restart a feature timeout, so have quantum_task() re-evaluate its deadlines
+        quantum_task_wake();
+    }
+
 #ifndef NO_ACTION_ONESHOT
     if (keymap_config.oneshot_enable) {
 #    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
@@ -132,6 +144,8 @@ void action_exec(keyevent_t event) {
         dprintln();
     }
 #endif
+
+    SCAN_STAGE_EXIT(SCAN_STAGE_ACTION_EXEC);
 }
 
 #ifdef SWAP_HANDS_ENABLE
@@ -271,6 +285,13 @@ void process_record(keyrecord_t *record) {
         return;
     }
 
+    // Records held back by tapping are processed on later ticks, so wake again
+    quantum_task_wake();
+
+#if defined(SPECULATIVE_HOLD) && !defined(NO_ACTION_TAPPING)
+    speculative_key_settled(record);
+#endif
+
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed && keymap_config.oneshot_enable) {
@@ -305,7 +326,14 @@ void process_record_handler(keyrecord_t *record) {
 #endif
     ac_dprintf("\n");
 
+#ifdef KEYBOARD_REPORT_BATCHING
+    // Only the reports of the action itself are held back, so that code run around it sends as it always has
+    bool was_holding = host_keyboard_batch_hold(true);
     process_action(record, action);
+    host_keyboard_batch_hold(was_holding);
+#else
+    process_action(record, action);
+#endif
 }
 
 /**
@@ -520,6 +548,7 @@ void process_action(keyrecord_t *record, action_t action) {
                     } else {
                         if (tap_count > 0) {
                             ac_dprintf("MODS_TAP: Tap: unregister_code\n");
+                            host_keyboard_flush();
                             if (action.layer_tap.code == KC_CAPS_LOCK) {
                                 wait_ms(TAP_HOLD_CAPS_DELAY);
                             } else {
@@ -700,6 +729,7 @@ void process_action(keyrecord_t *record, action_t action) {
                     } else {
                         if (tap_count > 0) {
                             ac_dprintf("KEYMAP_TAP_KEY: Tap: unregister_code\n");
+                            host_keyboard_flush();
                             if (action.layer_tap.code == KC_CAPS_LOCK) {
                                 wait_ms(TAP_HOLD_CAPS_DELAY);
                             } else {
@@ -717,6 +747,7 @@ void process_action(keyrecord_t *record, action_t action) {
                         register_code(action.layer_tap.code);
                     } else {
                         ac_dprintf("KEYMAP_TAP_KEY: Tap: unregister_code\n");
+                        host_keyboard_flush();
                         if (action.layer_tap.code == KC_CAPS) {
                             wait_ms(TAP_HOLD_CAPS_DELAY);
                         } else {
@@ -891,6 +922,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_CAPS_LOCK);
         send_keyboard_report();
+        host_keyboard_flush();
         wait_ms(TAP_HOLD_CAPS_DELAY);
         del_key(KC_CAPS_LOCK);
         send_keyboard_report();
@@ -901,6 +933,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_NUM_LOCK);
         send_keyboard_report();
+        host_keyboard_flush();
         wait_ms(100);
         del_key(KC_NUM_LOCK);
         send_keyboard_report();
@@ -911,6 +944,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
 #    endif
         add_key(KC_SCROLL_LOCK);
         send_keyboard_report();
+        host_keyboard_flush();
         wait_ms(100);
         del_key(KC_SCROLL_LOCK);
         send_keyboard_report();
@@ -1009,6 +1043,7 @@ __attribute__((weak)) void unregister_code(uint8_t code) {
  */
 __attribute__((weak)) void tap_code_delay(uint8_t code, uint16_t delay) {
     register_code(code);
+    host_keyboard_flush();
     wait_ms(delay);
     unregister_code(code);
 }
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,6 +317,45 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE)
+#    define LAYER_RESOLUTION_CACHE_INVALID 0xFF
+
+/** \brief Effective layer of each key, or LAYER_RESOLUTION_CACHE_INVALID if it needs to be resolved again */
+static uint8_t       layer_resolution_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t layer_resolution_cache_state;
+static bool          layer_resolution_cache_valid = false;
+
+/** \brief Layer resolution cache invalidate
+ *
+ * Forgets the effective layer of every key, so that each is resolved again from the keymap on its next press
+ */
+void layer_resolution_cache_invalidate(void) {
+    layer_resolution_cache_valid = false;
+}
+
+/** \brief Layer resolution cache update
+ *
+ * Brings the cache in line with the current layer state. A key's effective layer is unaffected by changes to the
+ * layers below it, so only the keys which resolved to or below the highest changed layer are forgotten.
+ */
+static void layer_resolution_cache_update(layer_state_t layers) {
+    if (!layer_resolution_cache_valid) {
+        memset(layer_resolution_cache, LAYER_RESOLUTION_CACHE_INVALID, sizeof(layer_resolution_cache));
+    } else if (layers != layer_resolution_cache_state) {
+        uint8_t highest_changed = get_highest_layer(layers ^ layer_resolution_cache_state);
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (layer_resolution_cache[row][col] <= highest_changed) {
+                    layer_resolution_cache[row][col] = LAYER_RESOLUTION_CACHE_INVALID;
+                }
+            }
+        }
+    }
+    layer_resolution_cache_state = layers;
+    layer_resolution_cache_valid = true;
+}
+#endif
+
 /** \brief Layer switch get layer
  *
  * Gets the layer based on key info
@@ -326,17 +366,33 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     action.code = ACTION_TRANSPARENT;
 
     layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_RESOLUTION_CACHE
+    // The layer state is compared on lookup rather than tracked on change, as split keyboards assign it directly
+    const bool cacheable = key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+    if (cacheable) {
+        layer_resolution_cache_update(layers);
+        if (layer_resolution_cache[key.row][key.col] != LAYER_RESOLUTION_CACHE_INVALID) {
+            return layer_resolution_cache[key.row][key.col];
+        }
+    }
+#    endif
+    uint8_t layer = 0; /* fall back to layer 0 */
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
             action = action_for_key(i, key);
             if (action.code != ACTION_TRANSPARENT) {
-                return i;
+                layer = i;
+                break;
             }
         }
     }
-    /* fall back to layer 0 */
-    return 0;
+#    ifdef LAYER_RESOLUTION_CACHE
+    if (cacheable) {
+        layer_resolution_cache[key.row][key.col] = layer;
+    }
+#    endif
+    return layer;
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -59,6 +59,20 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
+#    ifdef SPECULATIVE_HOLD
+#        include "action_util.h"
+#        include "keycode_config.h"
+#        include "quantum_keycodes.h"
+
+/* Ctrl and Shift do nothing on the host when tapped on their own, so they are the only mods that are safe to retract
+ * without DUMMY_MOD_NEUTRALIZER_KEYCODE.
+ */
+__attribute__((weak)) bool get_speculative_hold(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t mods = mod_config(QK_MOD_TAP_GET_MODS(keycode));
+    return (mods & (MOD_LCTL | MOD_LSFT)) == (mods & MOD_HYPR);
+}
+#    endif
+
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
@@ -73,6 +87,11 @@ static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
+#    ifdef SPECULATIVE_HOLD
+static void speculative_key_press(void);
+static void speculative_key_clear(void);
+#    endif
+
 /** \brief Action Tapping Process
  *
  * FIXME: Needs doc
@@ -91,6 +110,9 @@ void action_tapping_process(keyrecord_t record) {
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){0};
+#    ifdef SPECULATIVE_HOLD
+            speculative_key_clear();
+#    endif
         }
     }
 
@@ -107,6 +129,11 @@ void action_tapping_process(keyrecord_t record) {
             break;
         }
     }
+
+#    ifdef SPECULATIVE_HOLD
+    speculative_key_press();
+#    endif
+
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
@@ -520,6 +547,86 @@ void waiting_buffer_scan_tap(void) {
     }
 }
 
+#    ifdef SPECULATIVE_HOLD
+static bool     speculative_key_active = false;
+static keypos_t speculative_key        = {};
+// Mods registered by the speculative hold, which were not already active
+static uint8_t speculative_mods = 0;
+
+/** \brief Registers the mods of an undecided mod-tap key ahead of the tap/hold decision
+ *
+ * Only the tapping key is held speculatively. Events waiting behind it were all pressed after it, and are only
+ * processed once it has settled, so the mods never reach a key they were not meant for.
+ */
+static void speculative_key_press(void) {
+    if (speculative_key_active || IS_NOEVENT(tapping_key.event) || !tapping_key.event.pressed || tapping_key.tap.count > 0) {
+        return;
+    }
+
+    // The decision is made once per press, keys that are not held speculatively are tracked with no mods
+    speculative_key_active = true;
+    speculative_key        = tapping_key.event.key;
+    speculative_mods       = 0;
+
+    const uint16_t keycode = get_record_keycode(&tapping_key, false);
+    if (!IS_QK_MOD_TAP(keycode) || !get_speculative_hold(keycode, &tapping_key)) {
+        return;
+    }
+
+    uint8_t mods = mod_config(QK_MOD_TAP_GET_MODS(keycode));
+    mods         = (mods & 0x10) ? (mods & 0x0F) << 4 : mods;
+
+    speculative_mods = mods & ~get_mods();
+    ac_dprintf("Tapping: Speculative hold: mods=%02X\n", speculative_mods);
+    if (speculative_mods) {
+        register_mods(speculative_mods);
+    }
+}
+
+static void speculative_key_clear(void) {
+    speculative_key_active = false;
+    speculative_mods       = 0;
+}
+
+/** \brief Ends the speculative hold once the mod-tap key has been decided
+ *
+ * Called with every record before it is processed. On a hold the mods stay registered and become those of the hold
+ * action, on a tap they are released again before the tap keycode is sent.
+ */
+void speculative_key_settled(keyrecord_t *record) {
+    if (!speculative_key_active || !record->event.pressed || !KEYEQ(record->event.key, speculative_key)) {
+        return;
+    }
+
+    if (record->tap.count > 0 && speculative_mods) {
+        ac_dprintf("Tapping: Speculative hold: retract mods=%02X\n", speculative_mods);
+#        ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
+        neutralize_flashing_modifiers(get_mods());
+#        endif
+        unregister_mods(speculative_mods);
+    }
+    speculative_key_clear();
+}
+#    endif
+
+/** \brief Time until the tapping state machine next needs a tick
+ *
+ * \return 0 if events are waiting to be resolved, the number of milliseconds until the tapping key times out, or
+ *         UINT32_MAX if nothing is pending.
+ */
+uint32_t action_tapping_next_deadline(void) {
+    if (waiting_buffer_head != waiting_buffer_tail) {
+        return 0;
+    }
+    if (IS_NOEVENT(tapping_key.event)) {
+        return UINT32_MAX;
+    }
+
+    uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+    return elapsed >= term ? 0 : term - elapsed;
+}
+
 /** \brief Tapping key debug print
  *
  * FIXME: Needs docs
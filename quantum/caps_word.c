@@ -14,6 +14,7 @@
 
 #include <stdint.h>
 #include "caps_word.h"
+#include "keyboard.h"
 #include "timer.h"
 #include "action.h"
 #include "action_util.h"
@@ -39,11 +40,22 @@ void caps_word_task(void) {
 
 void caps_word_reset_idle_timer(void) {
     idle_timer = timer_read() + CAPS_WORD_IDLE_TIMEOUT;
+    quantum_task_wake();
 }
 #else
 void caps_word_task(void) {}
 #endif // CAPS_WORD_IDLE_TIMEOUT > 0
 
+uint32_t caps_word_next_deadline(void) {
+#if CAPS_WORD_IDLE_TIMEOUT > 0
+    if (caps_word_active) {
+        uint16_t now = timer_read();
+        return timer_expired(now, idle_timer) ? 0 : TIMER_DIFF_16(idle_timer, now);
+    }
+#endif // CAPS_WORD_IDLE_TIMEOUT > 0
+    return UINT32_MAX;
+}
+
 void caps_word_on(void) {
     if (caps_word_active) {
         return;
@@ -0,0 +1,188 @@
+/*
+Copyright 2026 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm, behaving the same as sym_defer_pk, using vertical counters.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+Instead of a byte per key, the counters of a row are stored as bit-planes: plane N holds bit N of the counter of
+every key in the row. Counting down is then a bit-sliced subtraction, advancing all keys of a row together with a
+handful of bitwise operations on matrix_row_t, regardless of the number of columns.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+// Number of bit-planes needed to hold a counter value of DEBOUNCE
+#if DEBOUNCE < 2
+#    define DEBOUNCE_PLANES 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_PLANES 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_PLANES 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_PLANES 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_PLANES 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_PLANES 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_PLANES 7
+#else
+#    define DEBOUNCE_PLANES 8
+#endif
+
+#define ROW_ALL ((matrix_row_t)~(matrix_row_t)0)
+#define PLANE_MASK(value, plane) (((value) >> (plane)) & 1 ? ROW_ALL : 0)
+
+#if DEBOUNCE > 0
+static matrix_row_t *debounce_planes;
+static fast_timer_t  last_time;
+static bool          counters_need_update;
+static bool          cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_planes = (matrix_row_t *)calloc(num_rows * DEBOUNCE_PLANES, sizeof(matrix_row_t));
+}
+
+void debounce_free(void) {
+    free(debounce_planes);
+    debounce_planes = NULL;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_row_t *planes = debounce_planes;
+    for (uint8_t row = 0; row < num_rows; row++, planes += DEBOUNCE_PLANES) {
+        // Keys with a non-zero counter are still debouncing
+        matrix_row_t active = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            active |= planes[plane];
+        }
+        if (!active) {
+            continue;
+        }
+
+        // Counters never exceed DEBOUNCE, so they have all expired once that much time has passed
+        matrix_row_t expired = active;
+        if (elapsed_time < DEBOUNCE) {
+            // Subtract elapsed_time from every counter, rippling the borrow through the planes
+            matrix_row_t remaining[DEBOUNCE_PLANES];
+            matrix_row_t borrow  = 0;
+            matrix_row_t nonzero = 0;
+            for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+                matrix_row_t counter  = planes[plane];
+                matrix_row_t subtract = PLANE_MASK(elapsed_time, plane);
+                remaining[plane]      = counter ^ subtract ^ borrow;
+                borrow                = (~counter & (subtract | borrow)) | (counter & subtract & borrow);
+                nonzero |= remaining[plane];
+            }
+            // A counter has expired if it was no greater than elapsed_time
+            expired = active & (borrow | ~nonzero);
+
+            matrix_row_t keep = active & ~expired;
+            for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+                planes[plane] = remaining[plane] & keep;
+            }
+            if (keep) {
+                counters_need_update = true;
+            }
+        } else {
+            for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+                planes[plane] = 0;
+            }
+        }
+
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_row_t *planes = debounce_planes;
+    for (uint8_t row = 0; row < num_rows; row++, planes += DEBOUNCE_PLANES) {
+        matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t active = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            active |= planes[plane];
+        }
+
+        // Start counters for keys that have changed, keep those already running, and stop those that changed back
+        matrix_row_t start = delta & ~active;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            planes[plane] = (planes[plane] & delta) | (start & PLANE_MASK(DEBOUNCE, plane));
+        }
+        if (start) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
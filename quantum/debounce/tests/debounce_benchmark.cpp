@@ -0,0 +1,121 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark_util.hpp"
+#include "debounce_trace.h"
+
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+class DebounceBenchmark : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(7777);
+        debounce_init(MATRIX_ROWS);
+    }
+
+    void TearDown() override {
+        debounce_free();
+    }
+
+    bool scan(bool changed, BenchmarkSeries &series) {
+        BenchmarkStopwatch stopwatch;
+        bool               cooked_changed = debounce(raw_, cooked_, MATRIX_ROWS, changed);
+        series.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        return cooked_changed;
+    }
+
+    matrix_row_t raw_[MATRIX_ROWS]    = {};
+    matrix_row_t cooked_[MATRIX_ROWS] = {};
+};
+
+TEST_F(DebounceBenchmark, Idle) {
+    BenchmarkSeries idle;
+
+    for (int ms = 0; ms < 10000; ms++) {
+        for (int i = 0; i < DEBOUNCE_TRACE_SCANS_PER_MS; i++) {
+            scan(false, idle);
+        }
+        advance_time(1);
+    }
+
+    BenchmarkReport report("debounce." DEBOUNCE_BENCHMARK_TYPE ".idle");
+    report.add("rows", MATRIX_ROWS);
+    report.add("cols", MATRIX_COLS);
+    report.add_series("scan", idle);
+    report.emit();
+}
+
+struct TraceScenario {
+    const char  *name;
+    TraceOptions options;
+    /* Whether every debounce algorithm must reproduce the intended changes exactly */
+    bool exact;
+};
+
+class DebounceTraceBenchmark : public ::testing::TestWithParam<TraceScenario> {};
+
+TEST_P(DebounceTraceBenchmark, Replay) {
+    const TraceScenario &scenario = GetParam();
+    SwitchTrace          trace    = synthesize_trace(scenario.name, 2026, scenario.options);
+    TraceResult          result   = replay_trace(trace);
+
+    EXPECT_EQ(result.matched + result.missed, result.intended);
+    if (scenario.exact) {
+        EXPECT_EQ(result.missed, 0);
+        EXPECT_EQ(result.duplicated, 0);
+    }
+
+    result.report("debounce." DEBOUNCE_BENCHMARK_TYPE "." + trace.name);
+}
+
+/* Bouncing stops within DEBOUNCE, so only the algorithm that does no debouncing gets it wrong */
+#define BOUNCE_WITHIN_DEBOUNCE (DEBOUNCE > 1 ? DEBOUNCE - 1 : 0)
+#define DEBOUNCING (DEBOUNCE > 0 && strcmp(DEBOUNCE_BENCHMARK_TYPE, "none") != 0)
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(Traces, DebounceTraceBenchmark, ::testing::Values(
+    TraceScenario{"clean", {.max_rollover = 1}, true},
+    TraceScenario{"bounce", {.max_rollover = 1, .bounce_ms = BOUNCE_WITHIN_DEBOUNCE}, DEBOUNCING},
+    TraceScenario{"chatter", {.max_rollover = 1, .bounce_ms = 2, .chatter_ppm = 200}, false},
+    TraceScenario{"rolls", {.max_rollover = 4, .chord_percent = 25, .bounce_ms = 2}, false},
+    TraceScenario{"ghosting", {.max_rollover = 3, .chord_percent = 30, .bounce_ms = 2, .ghosting = true}, false}
+), [](const ::testing::TestParamInfo<TraceScenario> &info) { return std::string(info.param.name); });
+// clang-format on
+
+TEST(DebounceRecordedTrace, Replay) {
+    /* A trace recorded from a keyboard, see load_trace() for the format */
+    const char *path = std::getenv("QMK_DEBOUNCE_TRACE");
+    if (!path) {
+        GTEST_SKIP() << "Set QMK_DEBOUNCE_TRACE to replay a recorded trace";
+    }
+    const char *settle = std::getenv("QMK_DEBOUNCE_TRACE_SETTLE_MS");
+
+    SwitchTrace trace  = load_trace(path, settle ? atoi(settle) : 20);
+    TraceResult result = replay_trace(trace);
+    EXPECT_EQ(result.matched + result.missed, result.intended);
+
+    result.report("debounce." DEBOUNCE_BENCHMARK_TYPE ".recorded." + trace.name);
+}
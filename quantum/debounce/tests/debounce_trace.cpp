@@ -0,0 +1,390 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "debounce_trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define ROW_BIT(col) ((matrix_row_t)1 << (col))
+
+/* Extra time at the end of each trace, so that every algorithm has settled */
+#define TRACE_TAIL_MS 500
+
+namespace {
+
+unsigned key_index(const TraceEdge &edge) {
+    return edge.row * MATRIX_COLS + edge.col;
+}
+
+void sort_edges(std::vector<TraceEdge> &edges) {
+    std::stable_sort(edges.begin(), edges.end(), [](const TraceEdge &a, const TraceEdge &b) { return a.scan < b.scan; });
+}
+
+/* In a matrix without diodes, current can flow through any chain of pressed keys sharing rows and columns */
+void apply_ghosting(matrix_row_t matrix[]) {
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (uint8_t a = 0; a < MATRIX_ROWS; a++) {
+            for (uint8_t b = a + 1; b < MATRIX_ROWS; b++) {
+                if ((matrix[a] & matrix[b]) && matrix[a] != matrix[b]) {
+                    matrix[a] = matrix[b] = matrix[a] | matrix[b];
+                    merged                = true;
+                }
+            }
+        }
+    }
+}
+
+std::vector<TraceEdge> synthesize_intended(std::mt19937 &rng, const TraceOptions &options) {
+    const uint32_t spm = DEBOUNCE_TRACE_SCANS_PER_MS;
+    const uint32_t end = options.duration_ms * spm;
+
+    /* A random number of scans, from lo_ms to hi_ms */
+    auto scans = [&](uint32_t lo_ms, uint32_t hi_ms) { return (lo_ms + rng() % (hi_ms - lo_ms + 1)) * spm + rng() % spm; };
+
+    struct Held {
+        uint8_t  row;
+        uint8_t  col;
+        uint32_t release;
+    };
+
+    std::vector<TraceEdge> intended;
+    std::vector<Held>      held;
+    std::vector<uint32_t>  free_at(MATRIX_ROWS * MATRIX_COLS, 0);
+    uint32_t               t = scans(10, 50);
+
+    while (t < end) {
+        held.erase(std::remove_if(held.begin(), held.end(), [&](const Held &h) { return h.release <= t; }), held.end());
+        if (held.size() >= options.max_rollover) {
+            t = std::min_element(held.begin(), held.end(), [](const Held &a, const Held &b) { return a.release < b.release; })->release + scans(5, 60);
+            continue;
+        }
+
+        /* Pick a key that is not held down, and was not released too recently. For ghosting, prefer keys sharing a
+         * row or column with a held key, which is what makes phantom keys appear. */
+        bool    found = false;
+        uint8_t row = 0, col = 0;
+        for (int attempt = 0; attempt < 16 && !found; attempt++) {
+            row = rng() % MATRIX_ROWS;
+            col = rng() % MATRIX_COLS;
+            if (options.ghosting && !held.empty() && rng() % 2) {
+                const Held &other = held[rng() % held.size()];
+                if (rng() % 2) {
+                    row = other.row;
+                } else {
+                    col = other.col;
+                }
+            }
+            found = free_at[row * MATRIX_COLS + col] <= t && std::none_of(held.begin(), held.end(), [&](const Held &h) { return h.row == row && h.col == col; });
+        }
+        if (!found) {
+            t += spm;
+            continue;
+        }
+
+        uint32_t release = t + scans(30, 150);
+        intended.push_back({t, row, col, true});
+        intended.push_back({release, row, col, false});
+        held.push_back({row, col, release});
+        free_at[row * MATRIX_COLS + col] = release + scans(20, 40);
+
+        if (held.size() < options.max_rollover && rng() % 100 < options.chord_percent) {
+            /* The next key goes down in the same scan */
+        } else if (options.max_rollover > 1) {
+            t += scans(15, 150);
+        } else {
+            t = release + scans(10, 120);
+        }
+    }
+
+    sort_edges(intended);
+    return intended;
+}
+
+} // namespace
+
+uint32_t TraceResult::latency_us(unsigned pct) const {
+    if (latency.empty()) {
+        return 0;
+    }
+    std::vector<uint32_t> sorted = latency;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[(sorted.size() - 1) * pct / 100] * 1000 / DEBOUNCE_TRACE_SCANS_PER_MS;
+}
+
+void TraceResult::report(const std::string &name) const {
+    BenchmarkReport report(name);
+    report.add("intended", intended);
+    report.add("matched", matched);
+    report.add("missed", missed);
+    report.add("duplicated", duplicated);
+    report.add("latency_us_p50", latency_us(50));
+    report.add("latency_us_p90", latency_us(90));
+    report.add("latency_us_p99", latency_us(99));
+    report.add("latency_us_max", latency_us(100));
+    report.add_series("scan", scan_cost);
+    report.emit();
+}
+
+SwitchTrace synthesize_trace(const std::string &name, uint32_t seed, const TraceOptions &options) {
+    const uint32_t spm = DEBOUNCE_TRACE_SCANS_PER_MS;
+    std::mt19937   rng(seed);
+    SwitchTrace    trace;
+
+    trace.name     = name;
+    trace.intended = synthesize_intended(rng, options);
+    trace.length   = (trace.intended.empty() ? 0 : trace.intended.back().scan) + TRACE_TAIL_MS * spm;
+
+    /* Simulate the switch contacts scan by scan, then what the matrix sees of them */
+    std::vector<uint32_t> bounce_until(MATRIX_ROWS * MATRIX_COLS, 0);
+    std::vector<unsigned> bouncing, pressed;
+    matrix_row_t          contact[MATRIX_ROWS] = {};
+    matrix_row_t          raw[MATRIX_ROWS]     = {};
+    size_t                next                 = 0;
+
+    auto set_contact = [&](unsigned key, bool value) {
+        matrix_row_t &row = contact[key / MATRIX_COLS];
+        row               = value ? (row | ROW_BIT(key % MATRIX_COLS)) : (row & ~ROW_BIT(key % MATRIX_COLS));
+    };
+
+    for (uint32_t scan = 0; scan < trace.length; scan++) {
+        std::vector<unsigned> edges;
+        for (; next < trace.intended.size() && trace.intended[next].scan == scan; next++) {
+            const TraceEdge &edge = trace.intended[next];
+            unsigned         key  = key_index(edge);
+            set_contact(key, edge.pressed);
+            edges.push_back(key);
+            if (edge.pressed) {
+                pressed.push_back(key);
+            } else {
+                pressed.erase(std::remove(pressed.begin(), pressed.end(), key), pressed.end());
+            }
+            if (options.bounce_ms > 0) {
+                bounce_until[key] = scan + rng() % (options.bounce_ms * spm + 1);
+                if (std::find(bouncing.begin(), bouncing.end(), key) == bouncing.end()) {
+                    bouncing.push_back(key);
+                }
+            }
+        }
+
+        /* Contacts bounce for a while after each change, before settling in the new state */
+        for (auto it = bouncing.begin(); it != bouncing.end();) {
+            unsigned key    = *it;
+            bool     target = std::find(pressed.begin(), pressed.end(), key) != pressed.end();
+            if (scan >= bounce_until[key]) {
+                set_contact(key, target);
+                it = bouncing.erase(it);
+                continue;
+            }
+            if (std::find(edges.begin(), edges.end(), key) == edges.end() && rng() % 2) {
+                contact[key / MATRIX_COLS] ^= ROW_BIT(key % MATRIX_COLS);
+            }
+            ++it;
+        }
+
+        /* Worn switches briefly lose contact while held */
+        if (options.chatter_ppm > 0) {
+            for (unsigned key : pressed) {
+                if (std::find(bouncing.begin(), bouncing.end(), key) == bouncing.end()) {
+                    set_contact(key, rng() % 1000000 >= options.chatter_ppm);
+                }
+            }
+        }
+
+        matrix_row_t next_raw[MATRIX_ROWS];
+        std::copy(std::begin(contact), std::end(contact), std::begin(next_raw));
+        if (options.ghosting) {
+            apply_ghosting(next_raw);
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            matrix_row_t delta = raw[row] ^ next_raw[row];
+            for (uint8_t col = 0; delta && col < MATRIX_COLS; col++) {
+                if (delta & ROW_BIT(col)) {
+                    trace.raw.push_back({scan, row, col, (next_raw[row] & ROW_BIT(col)) != 0});
+                    delta &= ~ROW_BIT(col);
+                }
+            }
+            raw[row] = next_raw[row];
+        }
+    }
+
+    return trace;
+}
+
+std::vector<TraceEdge> derive_intended(const std::vector<TraceEdge> &raw, uint32_t settle_scans) {
+    struct KeyState {
+        bool     stable      = false;
+        bool     level       = false;
+        bool     burst       = false;
+        uint32_t burst_start = 0;
+        uint32_t last        = 0;
+    };
+
+    std::map<unsigned, KeyState> keys;
+    std::vector<TraceEdge>       intended;
+
+    auto close_burst = [&](const TraceEdge &edge, KeyState &key) {
+        if (key.burst && key.level != key.stable) {
+            intended.push_back({key.burst_start, edge.row, edge.col, key.level});
+            key.stable = key.level;
+        }
+        key.burst = false;
+    };
+
+    for (auto &edge : raw) {
+        KeyState &key = keys[key_index(edge)];
+        if (key.burst && edge.scan - key.last >= settle_scans) {
+            close_burst(edge, key);
+        }
+        if (!key.burst) {
+            key.burst       = true;
+            key.burst_start = edge.scan;
+        }
+        key.level = edge.pressed;
+        key.last  = edge.scan;
+    }
+    for (auto &entry : keys) {
+        TraceEdge edge = {0, uint8_t(entry.first / MATRIX_COLS), uint8_t(entry.first % MATRIX_COLS), false};
+        close_burst(edge, entry.second);
+    }
+
+    sort_edges(intended);
+    return intended;
+}
+
+SwitchTrace load_trace(const std::string &path, uint32_t settle_ms) {
+    SwitchTrace   trace;
+    std::ifstream file(path);
+    std::string   line;
+
+    trace.name = path.substr(path.find_last_of('/') + 1);
+    EXPECT_TRUE(file.is_open()) << "Unable to open trace " << path;
+
+    while (std::getline(file, line)) {
+        unsigned long long time_us;
+        unsigned           row, col, pressed;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (sscanf(line.c_str(), "%llu %u %u %u", &time_us, &row, &col, &pressed) != 4 || row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+            ADD_FAILURE() << "Invalid trace line: " << line;
+            continue;
+        }
+        trace.raw.push_back({uint32_t(time_us * DEBOUNCE_TRACE_SCANS_PER_MS / 1000), uint8_t(row), uint8_t(col), pressed != 0});
+    }
+
+    sort_edges(trace.raw);
+    trace.intended = derive_intended(trace.raw, settle_ms * DEBOUNCE_TRACE_SCANS_PER_MS);
+    trace.length   = (trace.raw.empty() ? 0 : trace.raw.back().scan) + TRACE_TAIL_MS * DEBOUNCE_TRACE_SCANS_PER_MS;
+    return trace;
+}
+
+TraceResult score_trace(const std::vector<TraceEdge> &intended, const std::vector<TraceEdge> &cooked) {
+    std::map<unsigned, std::pair<std::vector<TraceEdge>, std::vector<TraceEdge>>> keys;
+    TraceResult                                                                   result;
+
+    for (auto &edge : intended) {
+        keys[key_index(edge)].first.push_back(edge);
+    }
+    for (auto &edge : cooked) {
+        keys[key_index(edge)].second.push_back(edge);
+    }
+
+    for (auto &entry : keys) {
+        const std::vector<TraceEdge> &want = entry.second.first;
+        const std::vector<TraceEdge> &got  = entry.second.second;
+        size_t                        j    = 0;
+
+        for (size_t i = 0; i < want.size(); i++) {
+            /* Cooked changes before this intended change did not come from it */
+            for (; j < got.size() && got[j].scan < want[i].scan; j++) {
+                result.duplicated++;
+            }
+            /* A cooked change arriving once the key has been pressed or released again can't be attributed to it */
+            uint32_t limit = i + 2 < want.size() ? want[i + 2].scan : UINT32_MAX;
+            if (j < got.size() && got[j].pressed == want[i].pressed && got[j].scan < limit) {
+                result.latency.push_back(got[j].scan - want[i].scan);
+                result.matched++;
+                j++;
+            } else {
+                result.missed++;
+            }
+        }
+        result.duplicated += got.size() - j;
+        result.intended += want.size();
+    }
+
+    return result;
+}
+
+TraceResult replay_trace(const SwitchTrace &trace) {
+    matrix_row_t           raw[MATRIX_ROWS]      = {};
+    matrix_row_t           cooked[MATRIX_ROWS]   = {};
+    matrix_row_t           previous[MATRIX_ROWS] = {};
+    std::vector<TraceEdge> cooked_edges;
+    BenchmarkSeries        scan_cost;
+    size_t                 next = 0;
+
+    set_time(7777);
+    debounce_init(MATRIX_ROWS);
+
+    for (uint32_t scan = 0; scan < trace.length; scan++) {
+        bool changed = false;
+        for (; next < trace.raw.size() && trace.raw[next].scan == scan; next++) {
+            const TraceEdge &edge = trace.raw[next];
+            raw[edge.row]         = edge.pressed ? (raw[edge.row] | ROW_BIT(edge.col)) : (raw[edge.row] & ~ROW_BIT(edge.col));
+            changed               = true;
+        }
+
+        BenchmarkStopwatch stopwatch;
+        debounce(raw, cooked, MATRIX_ROWS, changed);
+        scan_cost.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            matrix_row_t delta = cooked[row] ^ previous[row];
+            for (uint8_t col = 0; delta && col < MATRIX_COLS; col++) {
+                if (delta & ROW_BIT(col)) {
+                    cooked_edges.push_back({scan, row, col, (cooked[row] & ROW_BIT(col)) != 0});
+                    delta &= ~ROW_BIT(col);
+                }
+            }
+            previous[row] = cooked[row];
+        }
+
+        if ((scan + 1) % DEBOUNCE_TRACE_SCANS_PER_MS == 0) {
+            advance_time(1);
+        }
+    }
+
+    debounce_free();
+
+    TraceResult result = score_trace(trace.intended, cooked_edges);
+    result.scan_cost   = scan_cost;
+    return result;
+}
@@ -0,0 +1,86 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.hpp"
+
+extern "C" {
+#include "matrix.h"
+}
+
+/* Matrix scans per millisecond of simulated time. Trace times are counted in scans. */
+#ifndef DEBOUNCE_TRACE_SCANS_PER_MS
+#    define DEBOUNCE_TRACE_SCANS_PER_MS 4
+#endif
+
+struct TraceEdge {
+    uint32_t scan;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+/* A switch trace: what the typist did, and what the matrix saw */
+struct SwitchTrace {
+    std::string            name;
+    uint32_t               length = 0; // scans
+    std::vector<TraceEdge> intended;   // presses and releases, sorted by scan
+    std::vector<TraceEdge> raw;        // raw matrix changes, sorted by scan
+};
+
+struct TraceOptions {
+    uint32_t duration_ms   = 60000;
+    unsigned max_rollover  = 1;     // keys held down at once
+    unsigned chord_percent = 0;     // presses that land in the same scan as the previous press
+    uint32_t bounce_ms     = 0;     // longest contact bounce after each press or release
+    uint32_t chatter_ppm   = 0;     // chance per scan of a held key briefly losing contact, in parts per million
+    bool     ghosting      = false; // diodeless matrix, keys forming a rectangle with held keys appear pressed
+};
+
+struct TraceResult {
+    uint32_t              intended   = 0;
+    uint32_t              matched    = 0;
+    uint32_t              missed     = 0; // intended changes that never reached the cooked matrix
+    uint32_t              duplicated = 0; // cooked changes that do not correspond to an intended change
+    std::vector<uint32_t> latency;      // scans from each intended change to its cooked change
+    BenchmarkSeries       scan_cost;
+
+    uint32_t latency_us(unsigned pct) const;
+    void     report(const std::string &name) const;
+};
+
+/* Generates a pseudo-random typing trace, with the switch and matrix imperfections in options */
+SwitchTrace synthesize_trace(const std::string &name, uint32_t seed, const TraceOptions &options);
+
+/*
+ * Loads raw matrix changes recorded from a keyboard, one per line as "<time in us> <row> <col> <0|1>". Lines starting
+ * with '#' are ignored. The intended changes are those after which the key stayed in its new state for settle_ms.
+ */
+SwitchTrace load_trace(const std::string &path, uint32_t settle_ms);
+
+/* Works out the intended changes from raw matrix changes, ignoring any that do not last settle_scans */
+std::vector<TraceEdge> derive_intended(const std::vector<TraceEdge> &raw, uint32_t settle_scans);
+
+/* Matches the cooked matrix changes against the intended ones */
+TraceResult score_trace(const std::vector<TraceEdge> &intended, const std::vector<TraceEdge> &cooked);
+
+/* Replays the raw trace through debounce(), scoring the result and measuring the cost of each scan */
+TraceResult replay_trace(const SwitchTrace &trace);
@@ -0,0 +1,127 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "debounce_trace.h"
+
+#include <cstdio>
+#include <fstream>
+
+/* Checks of the trace harness itself, replaying through the algorithm that does no debouncing */
+
+TEST(DebounceTrace, ScoresLatency) {
+    std::vector<TraceEdge> intended = {{10, 0, 1, true}, {50, 0, 1, false}};
+    std::vector<TraceEdge> cooked   = {{14, 0, 1, true}, {58, 0, 1, false}};
+    TraceResult            result   = score_trace(intended, cooked);
+
+    EXPECT_EQ(result.intended, 2);
+    EXPECT_EQ(result.matched, 2);
+    EXPECT_EQ(result.missed, 0);
+    EXPECT_EQ(result.duplicated, 0);
+    EXPECT_EQ(result.latency, std::vector<uint32_t>({4, 8}));
+    EXPECT_EQ(result.latency_us(100), 8 * 1000 / DEBOUNCE_TRACE_SCANS_PER_MS);
+}
+
+TEST(DebounceTrace, ScoresMissedTap) {
+    /* A short tap swallowed entirely, followed by a tap that gets through late */
+    std::vector<TraceEdge> intended = {{10, 0, 1, true}, {12, 0, 1, false}, {50, 0, 1, true}, {80, 0, 1, false}};
+    std::vector<TraceEdge> cooked   = {{55, 0, 1, true}, {85, 0, 1, false}};
+    TraceResult            result   = score_trace(intended, cooked);
+
+    EXPECT_EQ(result.matched, 2);
+    EXPECT_EQ(result.missed, 2);
+    EXPECT_EQ(result.duplicated, 0);
+    EXPECT_EQ(result.latency, std::vector<uint32_t>({5, 5}));
+}
+
+TEST(DebounceTrace, ScoresChatterAndGhosts) {
+    /* Chatter on a held key, and a phantom key that was never pressed */
+    std::vector<TraceEdge> intended = {{10, 0, 1, true}, {100, 0, 1, false}};
+    std::vector<TraceEdge> cooked   = {{10, 0, 1, true}, {40, 0, 1, false}, {41, 0, 1, true}, {100, 0, 1, false}, {20, 1, 2, true}, {30, 1, 2, false}};
+    TraceResult            result   = score_trace(intended, cooked);
+
+    EXPECT_EQ(result.matched, 2);
+    EXPECT_EQ(result.missed, 0);
+    EXPECT_EQ(result.duplicated, 4);
+}
+
+TEST(DebounceTrace, DerivesIntendedChanges) {
+    const uint32_t         settle = 20;
+    std::vector<TraceEdge> raw    = {
+        /* Press with bounce, a brief loss of contact, then release */
+        {100, 2, 3, true}, {102, 2, 3, false}, {103, 2, 3, true}, {300, 2, 3, false}, {301, 2, 3, true}, {500, 2, 3, false},
+        /* A glitch on another key */
+        {200, 1, 1, true}, {201, 1, 1, false},
+    };
+    std::vector<TraceEdge> intended = derive_intended(raw, settle);
+
+    ASSERT_EQ(intended.size(), 2);
+    EXPECT_EQ(intended[0].scan, 100);
+    EXPECT_TRUE(intended[0].pressed);
+    EXPECT_EQ(intended[1].scan, 500);
+    EXPECT_FALSE(intended[1].pressed);
+}
+
+TEST(DebounceTrace, LoadsRecordedTrace) {
+    std::string path = testing::TempDir() + "debounce_trace_test.txt";
+    {
+        std::ofstream file(path);
+        file << "# time_us row col state\n";
+        file << "1000 0 1 1\n";
+        file << "1300 0 1 0\n";
+        file << "1600 0 1 1\n";
+        file << "90000 0 1 0\n";
+    }
+
+    SwitchTrace trace = load_trace(path, 5);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(trace.name, "debounce_trace_test.txt");
+    ASSERT_EQ(trace.raw.size(), 4);
+    EXPECT_EQ(trace.raw[1].scan, 1300 * DEBOUNCE_TRACE_SCANS_PER_MS / 1000);
+    ASSERT_EQ(trace.intended.size(), 2);
+    EXPECT_EQ(trace.intended[0].scan, trace.raw[0].scan);
+    EXPECT_GT(trace.length, trace.raw.back().scan);
+}
+
+TEST(DebounceTrace, CleanTraceReplaysExactly) {
+    SwitchTrace trace  = synthesize_trace("clean", 1, {.duration_ms = 5000, .max_rollover = 3, .chord_percent = 50});
+    TraceResult result = replay_trace(trace);
+
+    EXPECT_GT(result.intended, 0);
+    EXPECT_EQ(result.matched, result.intended);
+    EXPECT_EQ(result.duplicated, 0);
+    EXPECT_EQ(result.latency_us(100), 0);
+    EXPECT_EQ(result.scan_cost.count(), trace.length);
+}
+
+TEST(DebounceTrace, BounceShowsUpWithoutDebouncing) {
+    SwitchTrace trace  = synthesize_trace("bounce", 1, {.duration_ms = 5000, .bounce_ms = 3});
+    TraceResult result = replay_trace(trace);
+
+    EXPECT_EQ(result.matched, result.intended);
+    EXPECT_GT(result.duplicated, 0);
+}
+
+TEST(DebounceTrace, GhostKeysAppearInDiodelessMatrix) {
+    SwitchTrace trace = synthesize_trace("ghosting", 1, {.duration_ms = 20000, .max_rollover = 3, .chord_percent = 50, .ghosting = true});
+    TraceResult clean = score_trace(trace.intended, trace.intended);
+    TraceResult ghost = replay_trace(trace);
+
+    EXPECT_EQ(clean.duplicated, 0);
+    EXPECT_EQ(ghost.matched, ghost.intended);
+    EXPECT_GT(ghost.duplicated, 0);
+}
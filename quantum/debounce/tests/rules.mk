@@ -52,3 +52,35 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+debounce_sym_defer_pk_vc_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_pk_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_vc_tests.cpp
+
+debounce_sym_defer_pk_vc_wide_DEFS := -DMATRIX_ROWS=12 -DMATRIX_COLS=32 -DDEBOUNCE=200
+debounce_sym_defer_pk_vc_wide_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_vc_tests.cpp
+
+# Throughput and accuracy of each algorithm on a large (split keyboard sized) matrix, replaying switch traces
+DEBOUNCE_BENCHMARK_TYPES := none sym_defer_g sym_defer_pk sym_defer_pr sym_eager_pk sym_eager_pr asym_eager_defer_pk sym_defer_pk_vc
+
+define DEBOUNCE_BENCHMARK
+debounce_benchmark_$1_DEFS := -DMATRIX_ROWS=20 -DMATRIX_COLS=24 -DDEBOUNCE=5 -DDEBOUNCE_BENCHMARK_TYPE=\"$1\"
+debounce_benchmark_$1_INC := $(ROOT_DIR)tests/test_common
+debounce_benchmark_$1_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/$1.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_trace.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp
+endef
+
+$(foreach type,$(DEBOUNCE_BENCHMARK_TYPES),$(eval $(call DEBOUNCE_BENCHMARK,$(type))))
+
+debounce_trace_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_trace_INC := $(ROOT_DIR)tests/test_common
+debounce_trace_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_trace.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_trace_tests.cpp
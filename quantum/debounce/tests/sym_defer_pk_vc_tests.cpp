@@ -0,0 +1,128 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+/* Straightforward per-key model of sym_defer_pk, which the vertical counters must match exactly */
+class PerKeyModel {
+   public:
+    bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
+        bool updated_last   = false;
+        bool cooked_changed = false;
+
+        if (need_update_) {
+            fast_timer_t now     = timer_read_fast();
+            fast_timer_t elapsed = std::min<fast_timer_t>(TIMER_DIFF_FAST(now, last_time_), UINT8_MAX);
+            last_time_           = now;
+            updated_last         = true;
+            if (elapsed > 0) {
+                need_update_ = false;
+                for (int row = 0; row < MATRIX_ROWS; row++) {
+                    for (int col = 0; col < MATRIX_COLS; col++) {
+                        uint8_t& counter = counters_[row][col];
+                        if (counter == 0) {
+                            continue;
+                        }
+                        if (counter <= elapsed) {
+                            matrix_row_t bit  = (matrix_row_t)1 << col;
+                            matrix_row_t next = (cooked[row] & ~bit) | (raw[row] & bit);
+                            cooked_changed |= cooked[row] != next;
+                            cooked[row] = next;
+                            counter     = 0;
+                        } else {
+                            counter -= elapsed;
+                            need_update_ = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (changed) {
+            if (!updated_last) {
+                last_time_ = timer_read_fast();
+            }
+            for (int row = 0; row < MATRIX_ROWS; row++) {
+                matrix_row_t delta = raw[row] ^ cooked[row];
+                for (int col = 0; col < MATRIX_COLS; col++) {
+                    uint8_t& counter = counters_[row][col];
+                    if (delta & ((matrix_row_t)1 << col)) {
+                        if (counter == 0) {
+                            counter      = std::min(DEBOUNCE, UINT8_MAX);
+                            need_update_ = true;
+                        }
+                    } else {
+                        counter = 0;
+                    }
+                }
+            }
+        }
+
+        return cooked_changed;
+    }
+
+   private:
+    uint8_t      counters_[MATRIX_ROWS][MATRIX_COLS] = {};
+    fast_timer_t last_time_                          = 0;
+    bool         need_update_                        = false;
+};
+
+} // namespace
+
+TEST(DebounceVerticalCounter, MatchesPerKeyModel) {
+    std::mt19937 rng(DEBOUNCE);
+    PerKeyModel  model;
+    matrix_row_t raw[MATRIX_ROWS]          = {};
+    matrix_row_t cooked[MATRIX_ROWS]       = {};
+    matrix_row_t model_cooked[MATRIX_ROWS] = {};
+
+    set_time(7777);
+    debounce_init(MATRIX_ROWS);
+
+    for (int scan = 0; scan < 200000; scan++) {
+        /* Mostly quiet scans, with bursts of chatter on a few keys and occasional long gaps between scans */
+        bool changed = false;
+        if (rng() % 4 == 0) {
+            for (unsigned flips = 1 + rng() % 3; flips > 0; flips--) {
+                raw[rng() % MATRIX_ROWS] ^= (matrix_row_t)1 << (rng() % MATRIX_COLS);
+            }
+            changed = true;
+        }
+
+        bool cooked_changed       = debounce(raw, cooked, MATRIX_ROWS, changed);
+        bool model_cooked_changed = model.debounce(raw, model_cooked, changed);
+
+        ASSERT_EQ(cooked_changed, model_cooked_changed) << "scan " << scan;
+        ASSERT_TRUE(std::equal(std::begin(cooked), std::end(cooked), std::begin(model_cooked))) << "scan " << scan;
+
+        advance_time(rng() % 64 == 0 ? rng() % (2 * DEBOUNCE + 300) : rng() % 3);
+    }
+
+    debounce_free();
+}
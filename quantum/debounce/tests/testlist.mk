@@ -5,4 +5,15 @@ TEST_LIST += \
 	debounce_sym_defer_pr \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
-	debounce_asym_eager_defer_pk
+	debounce_asym_eager_defer_pk \
+	debounce_sym_defer_pk_vc \
+	debounce_sym_defer_pk_vc_wide \
+	debounce_trace \
+	debounce_benchmark_none \
+	debounce_benchmark_sym_defer_g \
+	debounce_benchmark_sym_defer_pk \
+	debounce_benchmark_sym_defer_pr \
+	debounce_benchmark_sym_eager_pk \
+	debounce_benchmark_sym_eager_pr \
+	debounce_benchmark_asym_eager_defer_pk \
+	debounce_benchmark_sym_defer_pk_vc
@@ -12,31 +12,113 @@
 //------------------------------------
 // Helpers
 //
+// Each table is kept as a binary min-heap ordered by trigger time. The heap is an array of slot indices, spread across
+// the heap_slot member of each entry, and each entry records its own position within the heap in heap_pos. Positions
+// below the heap count hold queued executors, positions from the heap count onwards hold free slots. Both members are
+// stored XOR'ed with their own index, so that a zero-initialised table is a valid, empty heap.
+//
+// Tokens are allocated so that (token - 1) % table_count is the slot holding the executor, allowing lookups without
+// searching the table.
 
 static deferred_token current_token = 0;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
-    }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+static inline uint8_t usable_count(size_t table_count) {
+    // Tokens are 8-bit, so no more than 255 executors can be queued in any one table
+    return table_count > UINT8_MAX ? UINT8_MAX : table_count;
+}
+
+static inline uint8_t heap_slot_at(deferred_executor_t *table, uint8_t pos) {
+    return table[pos].heap_slot ^ pos;
+}
+
+static inline uint8_t heap_pos_of(deferred_executor_t *table, uint8_t slot) {
+    return table[slot].heap_pos ^ slot;
+}
+
+static inline void heap_place(deferred_executor_t *table, uint8_t pos, uint8_t slot) {
+    table[pos].heap_slot = slot ^ pos;
+    table[slot].heap_pos = pos ^ slot;
+}
+
+static inline void heap_swap(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    uint8_t slot_a = heap_slot_at(table, a);
+    uint8_t slot_b = heap_slot_at(table, b);
+    heap_place(table, a, slot_b);
+    heap_place(table, b, slot_a);
+}
+
+static inline bool heap_before(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    return ((int32_t)TIMER_DIFF_32(table[heap_slot_at(table, a)].trigger_time, table[heap_slot_at(table, b)].trigger_time)) < 0;
+}
+
+static void heap_sift_up(deferred_executor_t *table, uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!heap_before(table, pos, parent)) {
+            break;
         }
+        heap_swap(table, pos, parent);
+        pos = parent;
     }
-    return true;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void heap_sift_down(deferred_executor_t *table, uint8_t count, uint8_t pos) {
+    while (true) {
+        uint16_t left     = 2 * (uint16_t)pos + 1;
+        uint16_t right    = left + 1;
+        uint8_t  earliest = pos;
+        if (left < count && heap_before(table, left, earliest)) {
+            earliest = left;
+        }
+        if (right < count && heap_before(table, right, earliest)) {
+            earliest = right;
+        }
+        if (earliest == pos) {
+            break;
         }
+        heap_swap(table, pos, earliest);
+        pos = earliest;
     }
-    return current_token;
+}
+
+static inline void heap_update(deferred_executor_t *table, uint8_t slot) {
+    uint8_t pos = heap_pos_of(table, slot);
+    heap_sift_up(table, pos);
+    heap_sift_down(table, table[0].heap_count, heap_pos_of(table, slot));
+}
+
+static void heap_remove(deferred_executor_t *table, uint8_t slot) {
+    uint8_t pos  = heap_pos_of(table, slot);
+    uint8_t last = --table[0].heap_count;
+
+    // Move the freed slot to the start of the free area, and fix up whichever executor took its place
+    heap_swap(table, pos, last);
+    if (pos < last) {
+        heap_update(table, heap_slot_at(table, pos));
+    }
+
+    deferred_executor_t *entry = &table[slot];
+    entry->token               = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time        = 0;
+    entry->callback            = NULL;
+    entry->cb_arg              = NULL;
+}
+
+static inline deferred_token allocate_token(uint8_t count, uint8_t slot) {
+    // Pick the next token after the previously allocated one that maps to the slot, so that recently used tokens are
+    // not immediately reused
+    uint16_t next  = (uint16_t)current_token + 1;
+    uint16_t token = next + (slot + 1 + count - (next % count)) % count;
+    if (token > UINT8_MAX) {
+        token = slot + 1;
+    }
+    current_token = token;
+    return token;
+}
+
+static inline deferred_executor_t *find_entry(deferred_executor_t *table, uint8_t count, deferred_token token) {
+    deferred_executor_t *entry = &table[(token - 1) % count];
+    return entry->token == token ? entry : NULL;
 }
 
 //------------------------------------
@@ -49,27 +131,24 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    uint8_t count = usable_count(table_count);
+    uint8_t pos   = table[0].heap_count;
+    if (pos >= count) {
+        // None available
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Claim the first free slot
+    uint8_t              slot  = heap_slot_at(table, pos);
+    deferred_executor_t *entry = &table[slot];
+    entry->token               = allocate_token(count, slot);
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+
+    table[0].heap_count++;
+    heap_sift_up(table, pos);
+    return entry->token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -78,18 +157,15 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
         return false;
     }
 
-    // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, usable_count(table_count), token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    entry->trigger_time = timer_read32() + delay_ms;
+    heap_update(table, entry - table);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -98,21 +174,14 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
         return false;
     }
 
-    // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, usable_count(table_count), token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    heap_remove(table, entry - table);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,40 +191,56 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
+        if (!table || table_count == 0) {
+            return;
+        }
+
+        // Run through the executors that are due, earliest first. Each pass is limited to as many executions as there
+        // were executors queued, so that a repeating executor which has fallen behind catches up over several passes.
+        for (uint8_t budget = table[0].heap_count; budget > 0 && table[0].heap_count > 0; --budget) {
+            uint8_t              slot       = heap_slot_at(table, 0);
+            deferred_executor_t *entry      = &table[slot];
             deferred_token       curr_token = entry->token;
 
             // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+            if (((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                break;
+            }
+
+            // Invoke the callback and work work out if we should be requeued
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
+            if (entry->token != curr_token) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                entry->trigger_time += delay_ms;
+                heap_update(table, slot);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                heap_remove(table, slot);
             }
         }
     }
 }
 
+uint32_t deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count) {
+    if (!table || table_count == 0 || table[0].heap_count == 0) {
+        return UINT32_MAX;
+    }
+
+    // The earliest executor is always at the top of the heap
+    int32_t remaining = (int32_t)TIMER_DIFF_32(table[heap_slot_at(table, 0)].trigger_time, timer_read32());
+    return remaining > 0 ? remaining : 0;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -175,3 +260,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+uint32_t deferred_exec_next_deadline(void) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS);
+}
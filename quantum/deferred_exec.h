@@ -65,6 +65,13 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Queries how long it will be until the next deferred executor is due, allowing idle loops to sleep until then.
+ *
+ * @return the number of milliseconds until the next deferred executor is due, 0 if one is already due, or UINT32_MAX if none are queued
+ */
+uint32_t deferred_exec_next_deadline(void);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -73,9 +80,13 @@ void deferred_exec_task(void);
  * @struct Structure for containing self-hosted deferred executor tables.
  * @brief Core-side code can use this to create their own tables without impacting on the use of users' ability to add deferred execution.
  *        Code outside deferred_exec.c should not worry about internals of this struct, and should just allocate the required number in an array.
+ *        Tables must be zero-initialised, and can hold at most 255 queued executors.
  */
 typedef struct deferred_executor_t {
     deferred_token         token;
+    uint8_t                heap_slot;  // slot index stored at this position of the trigger time heap
+    uint8_t                heap_pos;   // position of this slot within the trigger time heap
+    uint8_t                heap_count; // number of queued executors, only used in the first entry of a table
     uint32_t               trigger_time;
     deferred_exec_callback callback;
     void *                 cb_arg;
@@ -119,3 +130,12 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Queries how long it will be until the next deferred executor in a custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @return the number of milliseconds until the next deferred executor is due, 0 if one is already due, or UINT32_MAX if none are queued
+ */
+uint32_t deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count);
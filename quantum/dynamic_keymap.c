@@ -17,11 +17,20 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
+#include "keymap_common.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+#    include <string.h>
+#    include "keyboard.h"
+#    include "timer.h"
+#    include "util.h"
+#endif
+
 #ifdef VIA_ENABLE
 #    include "via.h"
 #    define DYNAMIC_KEYMAP_EEPROM_START (VIA_EEPROM_CONFIG_END)
@@ -101,6 +110,111 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// The keymaps, encoder maps and macros are contiguous, so a single window covers all of them
+#    define DYNAMIC_KEYMAP_RAM_MIRROR_SIZE ((DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + (DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) - (DYNAMIC_KEYMAP_EEPROM_ADDR))
+_Static_assert((DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) >= (DYNAMIC_KEYMAP_EEPROM_ADDR), "The dynamic keymap RAM mirror requires macros to be stored after the keymaps.");
+#    define DYNAMIC_KEYMAP_RAM_MIRROR_BLOCKS (((DYNAMIC_KEYMAP_RAM_MIRROR_SIZE) + (DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE)-1) / (DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE))
+
+static uint8_t  dynamic_keymap_mirror[DYNAMIC_KEYMAP_RAM_MIRROR_SIZE];
+static uint8_t  dynamic_keymap_mirror_dirty[((DYNAMIC_KEYMAP_RAM_MIRROR_BLOCKS) + 7) / 8];
+static bool     dynamic_keymap_mirror_loaded  = false;
+static bool     dynamic_keymap_mirror_pending = false;
+static uint32_t dynamic_keymap_mirror_last_write;
+
+static uint8_t *dynamic_keymap_mirror_byte(const void *address) {
+    uintptr_t offset = (uintptr_t)address - (DYNAMIC_KEYMAP_EEPROM_ADDR);
+    if (offset >= DYNAMIC_KEYMAP_RAM_MIRROR_SIZE) {
+        return NULL;
+    }
+    if (!dynamic_keymap_mirror_loaded) {
+        eeprom_read_block(dynamic_keymap_mirror, (const void *)(DYNAMIC_KEYMAP_EEPROM_ADDR), DYNAMIC_KEYMAP_RAM_MIRROR_SIZE);
+        dynamic_keymap_mirror_loaded = true;
+    }
+    return &dynamic_keymap_mirror[offset];
+}
+
+static inline bool dynamic_keymap_mirror_is_dirty(uint16_t block) {
+    return dynamic_keymap_mirror_dirty[block / 8] & (1 << (block % 8));
+}
+
+static uint8_t dynamic_keymap_read_byte(const void *address) {
+    uint8_t *byte = dynamic_keymap_mirror_byte(address);
+    return byte ? *byte : eeprom_read_byte(address);
+}
+
+static void dynamic_keymap_update_byte(void *address, uint8_t value) {
+    uint8_t *byte = dynamic_keymap_mirror_byte(address);
+    if (!byte) {
+        eeprom_update_byte(address, value);
+        return;
+    }
+    if (*byte == value) {
+        return;
+    }
+
+    *byte          = value;
+    uint16_t block = (byte - dynamic_keymap_mirror) / DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE;
+    dynamic_keymap_mirror_dirty[block / 8] |= 1 << (block % 8);
+    dynamic_keymap_mirror_pending    = true;
+    dynamic_keymap_mirror_last_write = timer_read32();
+    quantum_task_wake();
+}
+
+void dynamic_keymap_flush(void) {
+    if (!dynamic_keymap_mirror_pending) {
+        return;
+    }
+
+    // Write back each run of consecutive dirty blocks with a single update
+    for (uint16_t block = 0; block < DYNAMIC_KEYMAP_RAM_MIRROR_BLOCKS;) {
+        if (!dynamic_keymap_mirror_is_dirty(block)) {
+            block++;
+            continue;
+        }
+        uint16_t first = block;
+        while (block < DYNAMIC_KEYMAP_RAM_MIRROR_BLOCKS && dynamic_keymap_mirror_is_dirty(block)) {
+            block++;
+        }
+        uint16_t start = first * DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE;
+        uint16_t end   = MIN(block * DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE, DYNAMIC_KEYMAP_RAM_MIRROR_SIZE);
+        eeprom_update_block(&dynamic_keymap_mirror[start], (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + start), end - start);
+    }
+
+    memset(dynamic_keymap_mirror_dirty, 0, sizeof(dynamic_keymap_mirror_dirty));
+    dynamic_keymap_mirror_pending = false;
+}
+
+void dynamic_keymap_discard(void) {
+    memset(dynamic_keymap_mirror_dirty, 0, sizeof(dynamic_keymap_mirror_dirty));
+    dynamic_keymap_mirror_pending = false;
+    dynamic_keymap_mirror_loaded  = false;
+}
+
+void dynamic_keymap_task(void) {
+    if (dynamic_keymap_mirror_pending && timer_elapsed32(dynamic_keymap_mirror_last_write) >= DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY) {
+        dynamic_keymap_flush();
+    }
+}
+
+uint32_t dynamic_keymap_next_deadline(void) {
+    if (!dynamic_keymap_mirror_pending) {
+        return UINT32_MAX;
+    }
+
+    uint32_t elapsed = timer_elapsed32(dynamic_keymap_mirror_last_write);
+    return elapsed >= DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY ? 0 : DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY - elapsed;
+}
+#else
+static inline uint8_t dynamic_keymap_read_byte(const void *address) {
+    return eeprom_read_byte(address);
+}
+
+static inline void dynamic_keymap_update_byte(void *address, uint8_t value) {
+    eeprom_update_byte(address, value);
+}
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -114,8 +228,8 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_read_byte(address) << 8;
+    keycode |= dynamic_keymap_read_byte(address + 1);
     return keycode;
 }
 
@@ -123,8 +237,14 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE)
+    layer_resolution_cache_invalidate();
+#endif
+#if DECODED_ACTION_CACHE_LAYERS > 0
+    decoded_action_cache_invalidate_key(layer, row, column);
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -136,8 +256,8 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -145,8 +265,8 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -169,11 +289,11 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -184,15 +304,21 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
     }
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE)
+    layer_resolution_cache_invalidate();
+#endif
+#if DECODED_ACTION_CACHE_LAYERS > 0
+    decoded_action_cache_invalidate();
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,11 +346,11 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -234,11 +360,11 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
@@ -249,7 +375,7 @@ void dynamic_keymap_macro_reset(void) {
     void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
     void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
-        eeprom_update_byte(p, 0);
+        dynamic_keymap_update_byte(p, 0);
         ++p;
     }
 }
@@ -264,7 +390,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // of buffer writing, possibly an aborted buffer
     // write. So do nothing.
     void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    if (dynamic_keymap_read_byte(p) != 0) {
         return;
     }
 
@@ -278,7 +404,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
         if (p == end) {
             return;
         }
-        if (eeprom_read_byte(p) == 0) {
+        if (dynamic_keymap_read_byte(p) == 0) {
             --id;
         }
         ++p;
@@ -289,7 +415,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
+        data[0] = dynamic_keymap_read_byte(p++);
         data[1] = 0;
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
@@ -297,14 +423,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         if (data[0] == SS_QMK_PREFIX) {
             // Get the code
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_read_byte(p++);
             // Unexpected null, abort.
             if (data[1] == 0) {
                 return;
             }
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_read_byte(p++);
                 // Unexpected null, abort.
                 if (data[2] == 0) {
                     return;
@@ -316,7 +442,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 // At most this is 4 digits plus '|'
                 uint8_t i = 2;
                 while (1) {
-                    data[i] = eeprom_read_byte(p++);
+                    data[i] = dynamic_keymap_read_byte(p++);
                     // Unexpected null, abort
                     if (data[i] == 0) {
                         return;
@@ -68,3 +68,23 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+#    ifndef DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY
+#        define DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY 500
+#    endif
+
+#    ifndef DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE
+#        define DYNAMIC_KEYMAP_RAM_MIRROR_BLOCK_SIZE 32
+#    endif
+
+// With the RAM mirror enabled, writes are batched and committed to EEPROM after
+// DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY milliseconds without further changes.
+// dynamic_keymap_flush() commits any outstanding changes immediately.
+void     dynamic_keymap_flush(void);
+// dynamic_keymap_discard() drops any outstanding changes, and reloads the mirror
+// from EEPROM when it is next used. Called when EEPROM is reset underneath it.
+void     dynamic_keymap_discard(void);
+void     dynamic_keymap_task(void);
+uint32_t dynamic_keymap_next_deadline(void);
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
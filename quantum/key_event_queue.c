@@ -0,0 +1,82 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_event_queue.h"
+#include "action.h"
+#include "debug.h"
+
+#define KEY_EVENT_QUEUE_MASK (KEY_EVENT_QUEUE_SIZE - 1)
+
+// Single-producer single-consumer ring: pushes write at head, pops read at tail.
+static keyevent_t queue[KEY_EVENT_QUEUE_SIZE];
+static uint8_t    queue_head = 0;
+static uint8_t    queue_tail = 0;
+
+// Written by the producer only
+static uint8_t  max_depth = 0;
+static uint16_t overflows = 0;
+static uint32_t pushed    = 0;
+
+bool key_event_queue_push(keyevent_t event) {
+    uint8_t head  = queue_head;
+    uint8_t depth = (head - __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) & 0xFF;
+    if (depth >= KEY_EVENT_QUEUE_SIZE) {
+        if (overflows < UINT16_MAX) {
+            overflows++;
+        }
+        return false;
+    }
+    queue[head & KEY_EVENT_QUEUE_MASK] = event;
+    __atomic_store_n(&queue_head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+
+    pushed++;
+    if (depth + 1 > max_depth) {
+        max_depth = depth + 1;
+    }
+    return true;
+}
+
+bool key_event_queue_pop(keyevent_t *event) {
+    uint8_t tail = queue_tail;
+    if (tail == __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *event = queue[tail & KEY_EVENT_QUEUE_MASK];
+    __atomic_store_n(&queue_tail, (uint8_t)(tail + 1), __ATOMIC_RELEASE);
+    return true;
+}
+
+uint8_t key_event_queue_depth(void) {
+    return (__atomic_load_n(&queue_head, __ATOMIC_ACQUIRE) - __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) & 0xFF;
+}
+
+key_event_queue_stats_t key_event_queue_stats(void) {
+    return (key_event_queue_stats_t){
+        .depth     = key_event_queue_depth(),
+        .max_depth = max_depth,
+        .overflows = overflows,
+        .pushed    = pushed,
+    };
+}
+
+void key_event_queue_reset_stats(void) {
+    max_depth = 0;
+    overflows = 0;
+    pushed    = 0;
+}
+
+bool key_event_queue_task(void) {
+    static uint16_t reported_overflows = 0;
+    if (overflows != reported_overflows) {
+        dprintf("key event queue: %u overflows\n", overflows);
+        reported_overflows = overflows;
+    }
+
+    keyevent_t event;
+    uint8_t    processed = 0;
+    while ((KEY_EVENT_QUEUE_DRAIN_LIMIT == 0 || processed < KEY_EVENT_QUEUE_DRAIN_LIMIT) && key_event_queue_pop(&event)) {
+        action_exec(event);
+        processed++;
+    }
+    return processed > 0;
+}
@@ -0,0 +1,75 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+/*
+    Key event queue.
+
+    matrix_task() stamps every change found by a scan with the time of that scan and pushes it here, instead of calling
+    action_exec() for each change in turn. keyboard_task() then drains the queue through action_exec(). A slow
+    process_record chain therefore no longer delays the events behind it, and tapping, combo and tap dance decisions
+    see when each key actually changed.
+
+    The queue has a single producer and a single consumer, so events may also be pushed from an interrupt handler. When
+    it is full, matrix_task() leaves the change in place, so that the next scan finds it again.
+*/
+
+#ifndef KEY_EVENT_QUEUE_SIZE
+#    define KEY_EVENT_QUEUE_SIZE 16
+#endif
+
+#if KEY_EVENT_QUEUE_SIZE < 2 || KEY_EVENT_QUEUE_SIZE > 128 || (KEY_EVENT_QUEUE_SIZE & (KEY_EVENT_QUEUE_SIZE - 1)) != 0
+#    error KEY_EVENT_QUEUE_SIZE must be a power of two between 2 and 128
+#endif
+
+// Events processed per pass of the main loop, 0 for all of them
+#ifndef KEY_EVENT_QUEUE_DRAIN_LIMIT
+#    define KEY_EVENT_QUEUE_DRAIN_LIMIT 0
+#endif
+
+typedef struct key_event_queue_stats_t {
+    uint8_t  depth;     // events waiting to be processed
+    uint8_t  max_depth; // most events ever waiting at once
+    uint16_t overflows; // events that found the queue full
+    uint32_t pushed;    // events accepted
+} key_event_queue_stats_t;
+
+/**
+ * @brief Adds an event to the back of the queue. Safe to call from an interrupt handler.
+ *
+ * @return false if the queue is full, in which case the event is counted as an overflow and dropped
+ */
+bool key_event_queue_push(keyevent_t event);
+
+/**
+ * @brief Takes the event at the front of the queue.
+ *
+ * @return false if the queue is empty
+ */
+bool key_event_queue_pop(keyevent_t *event);
+
+/**
+ * @brief The number of events waiting to be processed.
+ */
+uint8_t key_event_queue_depth(void);
+
+/**
+ * @brief Reports the depth and overflow counters.
+ */
+key_event_queue_stats_t key_event_queue_stats(void);
+
+/**
+ * @brief Clears the maximum depth and overflow counters.
+ */
+void key_event_queue_reset_stats(void);
+
+/**
+ * @brief Passes queued events to action_exec(), up to KEY_EVENT_QUEUE_DRAIN_LIMIT of them. Called by the core.
+ *
+ * @return true if any event was processed
+ */
+bool key_event_queue_task(void);
@@ -32,6 +32,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "action_tapping.h"
+#include "action_util.h"
+#include "scan_stage.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -104,6 +107,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -140,6 +146,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef MATRIX_IDLE_ENABLE
+#    include "matrix_idle.h"
+#endif
+#ifdef KEY_EVENT_QUEUE_ENABLE
+#    include "key_event_queue.h"
+#endif
+#ifdef KEYSTROKE_TRACE_ENABLE
+#    include "keystroke_trace.h"
+#endif
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -528,6 +546,13 @@ static inline void generate_tick_event(void) {
  * @return false Matrix didn't change
  */
 static bool matrix_task(void) {
+#ifdef MATRIX_IDLE_ENABLE
+    // Nothing is pressed or pending, so neither scans nor tick events are needed
+    if (!matrix_idle_should_scan()) {
+        return false;
+    }
+#endif
+
     if (!matrix_can_read()) {
         generate_tick_event();
         return false;
@@ -536,6 +561,10 @@ static bool matrix_task(void) {
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
+#ifdef KEY_EVENT_QUEUE_ENABLE
+    // Every change found by this scan happened now, however long the ones before it take to process
+    const uint16_t scan_time = timer_read();
+#endif
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
         matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
@@ -545,7 +574,11 @@ static bool matrix_task(void) {
 
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
-        generate_tick_event();
+#ifdef KEY_EVENT_QUEUE_ENABLE
+        // A tick ahead of queued events could time out a key those events would have resolved
+        if (key_event_queue_depth() == 0)
+#endif
+            generate_tick_event();
         return matrix_changed;
     }
 
@@ -564,24 +597,108 @@ static bool matrix_task(void) {
         }
 
         matrix_row_t col_mask = 1;
+        matrix_row_t deferred = 0;
         for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
             if (row_changes & col_mask) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
+#ifdef KEY_EVENT_QUEUE_ENABLE
+                    keyevent_t event = MAKE_KEYEVENT(row, col, key_pressed);
+                    event.time       = scan_time;
+                    if (!key_event_queue_push(event)) {
+                        // Queue full, leave the change for the next scan to find
+                        deferred |= col_mask;
+                        continue;
+                    }
+#else
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+#endif
                 }
 
                 switch_events(row, col, key_pressed);
             }
         }
 
-        matrix_previous[row] = current_row;
+        matrix_previous[row] = current_row ^ deferred;
     }
 
     return matrix_changed;
 }
 
+/** \brief A periodic task of a quantum feature
+ *
+ * If next_deadline is provided, it returns the number of milliseconds until the task next needs to run, 0 if it is
+ * already due, or UINT32_MAX if it has nothing pending. Tasks without one are run on every pass.
+ */
+typedef struct quantum_task_t {
+    void (*task)(void);
+    uint32_t (*next_deadline)(void);
+    uint32_t due;
+    bool     pending; // false if the task had nothing pending when it last ran
+#ifdef PROFILER_ENABLE
+    profiler_zone_t zone;
+#endif
+} quantum_task_t;
+
+#ifdef PROFILER_ENABLE
+// Per-task runtime is recorded as zones nested within the quantum_task scan stage
+#    define QUANTUM_TASK(fn, deadline) {.task = (fn), .next_deadline = (deadline), .zone = {.name = #fn, .id = PROFILER_INVALID_ZONE}}
+#else
+#    define QUANTUM_TASK(fn, deadline) {.task = (fn), .next_deadline = (deadline)}
+#endif
+
+// Deadlines are capped so that the due time always compares as being in the future
+#define QUANTUM_TASK_MAX_DEADLINE 0x3FFFFFFF
+
+static quantum_task_t quantum_tasks[] = {
+#if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
+    QUANTUM_TASK(music_task, NULL),
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    QUANTUM_TASK(key_override_task, key_override_next_deadline),
+#endif
+#ifdef SEQUENCER_ENABLE
+    QUANTUM_TASK(sequencer_task, NULL),
+#endif
+#ifdef TAP_DANCE_ENABLE
+    QUANTUM_TASK(tap_dance_task, tap_dance_next_deadline),
+#endif
+#ifdef COMBO_ENABLE
+    QUANTUM_TASK(combo_task, combo_next_deadline),
+#endif
+#ifdef LEADER_ENABLE
+    QUANTUM_TASK(leader_task, leader_next_deadline),
+#endif
+#ifdef WPM_ENABLE
+    QUANTUM_TASK(decay_wpm, NULL),
+#endif
+#ifdef DIP_SWITCH_ENABLE
+    QUANTUM_TASK(dip_switch_task, NULL),
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    QUANTUM_TASK(autoshift_matrix_scan, NULL),
+#endif
+#ifdef CAPS_WORD_ENABLE
+    QUANTUM_TASK(caps_word_task, caps_word_next_deadline),
+#endif
+#ifdef SECURE_ENABLE
+    QUANTUM_TASK(secure_task, secure_next_deadline),
+#endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    QUANTUM_TASK(dynamic_keymap_task, dynamic_keymap_next_deadline),
+#endif
+#ifdef KEYSTROKE_TRACE_ENABLE
+    QUANTUM_TASK(keystroke_trace_task, NULL),
+#endif
+};
+
+static bool quantum_task_woken = true;
+
+void quantum_task_wake(void) {
+    quantum_task_woken = true;
+}
+
 /** \brief Tasks previously located in matrix_scan_quantum
  *
  * TODO: rationalise against keyboard_task and current split role
@@ -612,60 +729,117 @@ void quantum_task(void) {
     }
 #endif
 
-#if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
-    music_task();
-#endif
+    // Tasks which register a deadline are only run once it has passed, or after quantum_task_wake()
+    bool     woken     = quantum_task_woken;
+    uint32_t now       = timer_read32();
+    quantum_task_woken = false;
 
-#ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
-#endif
+    for (uint8_t i = 0; i < ARRAY_SIZE(quantum_tasks); i++) {
+        quantum_task_t *entry = &quantum_tasks[i];
+        if (entry->next_deadline && !woken && ((int32_t)TIMER_DIFF_32(entry->due, now)) > 0) {
+            continue;
+        }
 
-#ifdef SEQUENCER_ENABLE
-    sequencer_task();
+#ifdef PROFILER_ENABLE
+        profiler_zone_enter(&entry->zone);
 #endif
-
-#ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+        entry->task();
+#ifdef PROFILER_ENABLE
+        profiler_zone_exit(&entry->zone);
 #endif
 
-#ifdef COMBO_ENABLE
-    combo_task();
-#endif
+        if (entry->next_deadline) {
+            uint32_t deadline = entry->next_deadline();
+            entry->due        = now + MIN(deadline, QUANTUM_TASK_MAX_DEADLINE);
+            entry->pending    = deadline != UINT32_MAX;
+        }
+    }
+}
 
-#ifdef LEADER_ENABLE
-    leader_task();
+#if defined(SPLIT_KEYBOARD) || defined(MATRIX_IDLE_ENABLE) || defined(AUDIO_ENABLE) || defined(RGBLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE) || defined(RGB_MATRIX_ENABLE) || defined(BACKLIGHT_ENABLE) || defined(ENCODER_ENABLE) || defined(POINTING_DEVICE_ENABLE) || defined(OLED_ENABLE) || defined(ST7565_ENABLE) || defined(MOUSEKEY_ENABLE) || defined(PS2_MOUSE_ENABLE) || defined(MIDI_ENABLE) || defined(JOYSTICK_ENABLE) || defined(BLUETOOTH_ENABLE) || defined(HAPTIC_ENABLE) || defined(OS_DETECTION_ENABLE) || (defined(SWAP_HANDS_ENABLE) && defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+// These do their work on every pass of keyboard_task(), and do not report when they next need to
+#    define KEYBOARD_TASK_EVERY_PASS
 #endif
 
-#ifdef WPM_ENABLE
-    decay_wpm();
-#endif
+/** \brief Time until quantum_task() next has a task to run
+ */
+uint32_t quantum_task_next_deadline(void) {
+    if (quantum_task_woken) {
+        return 0;
+    }
 
-#ifdef DIP_SWITCH_ENABLE
-    dip_switch_task();
-#endif
+    uint32_t now      = timer_read32();
+    uint32_t deadline = UINT32_MAX;
+    for (uint8_t i = 0; i < ARRAY_SIZE(quantum_tasks); i++) {
+        quantum_task_t *entry = &quantum_tasks[i];
+        if (!entry->next_deadline) {
+            return 0;
+        }
+        if (!entry->pending) {
+            continue;
+        }
+        int32_t remaining = TIMER_DIFF_32(entry->due, now);
+        if (remaining <= 0) {
+            return 0;
+        }
+        deadline = MIN(deadline, (uint32_t)remaining);
+    }
+    return deadline;
+}
 
-#ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+uint32_t keyboard_task_next_deadline(void) {
+#ifdef KEY_EVENT_QUEUE_ENABLE
+    if (key_event_queue_depth() > 0) {
+        return 0;
+    }
+#endif
+#if !defined(NO_ACTION_ONESHOT) && defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0)
+    // One shot timeouts are checked by every event, ticks included
+    if (get_oneshot_mods() || get_oneshot_layer_state()) {
+        return 0;
+    }
 #endif
 
-#ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    uint32_t deadline = quantum_task_next_deadline();
+#ifndef NO_ACTION_TAPPING
+    deadline = MIN(deadline, action_tapping_next_deadline());
 #endif
+    return deadline;
+}
 
-#ifdef SECURE_ENABLE
-    secure_task();
+uint32_t keyboard_next_deadline(void) {
+#ifdef KEYBOARD_TASK_EVERY_PASS
+    return 0;
+#else
+    return keyboard_task_next_deadline();
 #endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+
+#ifdef KEYBOARD_REPORT_BATCHING
+    // Keys changing in this scan are sent to the host together, once all of them are processed
+    host_keyboard_batch_begin();
+#endif
+    SCAN_STAGE_ENTER(SCAN_STAGE_MATRIX_TASK);
+    const bool matrix_changed = matrix_task();
+    SCAN_STAGE_EXIT(SCAN_STAGE_MATRIX_TASK);
+#ifdef KEY_EVENT_QUEUE_ENABLE
+    key_event_queue_task();
+#endif
+#ifdef KEYBOARD_REPORT_BATCHING
+    host_keyboard_batch_end();
+#endif
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
+    SCAN_STAGE_ENTER(SCAN_STAGE_QUANTUM_TASK);
     quantum_task();
+    SCAN_STAGE_EXIT(SCAN_STAGE_QUANTUM_TASK);
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
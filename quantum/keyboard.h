@@ -139,6 +139,28 @@ void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timesta
 
 uint32_t get_matrix_scan_rate(void);
 
+void quantum_task_wake(void); // Runs every quantum feature task on the next pass, e.g. after a feature timeout has been (re)started
+
+/**
+ * @brief The number of milliseconds until keyboard_task() next has work to do, if the matrix does not change.
+ *
+ * Returns 0 if it has work to do now, or if a feature is enabled which works on every pass, and UINT32_MAX if nothing
+ * is pending. Passes of keyboard_task() before then can be skipped, as the tests do to get through idle time quickly.
+ */
+uint32_t keyboard_next_deadline(void);
+
+/**
+ * @brief The number of milliseconds until the quantum feature tasks, the tapping state machine, one shot timeouts or
+ * queued key events next need a pass of keyboard_task().
+ *
+ * Unlike keyboard_next_deadline(), this leaves out the features which work on every pass, for callers such as
+ * MATRIX_IDLE_ENABLE that account for those themselves.
+ */
+uint32_t keyboard_task_next_deadline(void);
+
+// The number of milliseconds until quantum_task() next has a task to run, 0 if one is due, or UINT32_MAX if none is
+uint32_t quantum_task_next_deadline(void);
+
 #ifdef __cplusplus
 }
 #endif
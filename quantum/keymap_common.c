@@ -15,8 +15,10 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
 #include "keymap_common.h"
 #include "keymap_introspection.h"
+#include "matrix.h"
 #include "report.h"
 #include "keycode.h"
 #include "action_layer.h"
@@ -45,8 +47,43 @@ extern keymap_config_t keymap_config;
 
 #include <inttypes.h>
 
+#if DECODED_ACTION_CACHE_LAYERS > 0
+// Decoded actions of the lowest layers, each valid only while its bit is set in decoded_action_cache_valid
+static action_t     decoded_action_cache[DECODED_ACTION_CACHE_LAYERS][MATRIX_ROWS][MATRIX_COLS];
+static matrix_row_t decoded_action_cache_valid[DECODED_ACTION_CACHE_LAYERS][MATRIX_ROWS];
+// Keycode remapping depends on keymap_config, which is also written directly, so the cache tracks the value it was
+// filled with rather than relying on every writer to invalidate it
+static uint16_t decoded_action_cache_config;
+
+void decoded_action_cache_invalidate(void) {
+    memset(decoded_action_cache_valid, 0, sizeof(decoded_action_cache_valid));
+}
+
+void decoded_action_cache_invalidate_key(uint8_t layer, uint8_t row, uint8_t col) {
+    if (layer < DECODED_ACTION_CACHE_LAYERS && row < MATRIX_ROWS && col < MATRIX_COLS) {
+        decoded_action_cache_valid[layer][row] &= ~(MATRIX_ROW_SHIFTER << col);
+    }
+}
+#endif
+
 /* converts key to action */
 action_t action_for_key(uint8_t layer, keypos_t key) {
+#if DECODED_ACTION_CACHE_LAYERS > 0
+    if (layer < DECODED_ACTION_CACHE_LAYERS && key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        if (keymap_config.raw != decoded_action_cache_config) {
+            decoded_action_cache_invalidate();
+            decoded_action_cache_config = keymap_config.raw;
+        }
+
+        action_t *    cached = &decoded_action_cache[layer][key.row][key.col];
+        matrix_row_t *valid  = &decoded_action_cache_valid[layer][key.row];
+        if (!(*valid & (MATRIX_ROW_SHIFTER << key.col))) {
+            *cached = action_for_keycode(keymap_key_to_keycode(layer, key));
+            *valid |= MATRIX_ROW_SHIFTER << key.col;
+        }
+        return *cached;
+    }
+#endif
     // 16bit keycodes - important
     uint16_t keycode = keymap_key_to_keycode(layer, key);
     return action_for_keycode(keycode);
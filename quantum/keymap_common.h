@@ -8,3 +8,14 @@
 
 // translates key to keycode
 uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+
+#ifndef DECODED_ACTION_CACHE_LAYERS
+#    define DECODED_ACTION_CACHE_LAYERS 0
+#endif
+
+#if DECODED_ACTION_CACHE_LAYERS > 0
+// forgets all cached actions, required whenever the keymap changes other than through the dynamic keymap
+void decoded_action_cache_invalidate(void);
+// forgets the cached action of a single key
+void decoded_action_cache_invalidate_key(uint8_t layer, uint8_t row, uint8_t col);
+#endif
@@ -112,6 +112,48 @@ __attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
     return combo_get_raw(combo_idx);
 }
 
+bool combo_generated_index_find_raw(uint16_t keycode, const combo_key_ref_t** refs, uint16_t* count) {
+#    if defined(COMBO_GENERATED_INDEX)
+    _Static_assert(ARRAY_SIZE(combo_index_offsets) == ARRAY_SIZE(combo_index_keycodes) + 1, "Generated combo index is inconsistent");
+
+    // The generator sorts the keycodes by value, and merges the different spellings of each
+    uint16_t low = 0, high = ARRAY_SIZE(combo_index_keycodes);
+    *count       = 0;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        uint16_t key = pgm_read_word(&combo_index_keycodes[mid]);
+        if (key == keycode) {
+            uint16_t start = pgm_read_word(&combo_index_offsets[mid]);
+            *refs          = &combo_index_refs[start];
+            *count         = pgm_read_word(&combo_index_offsets[mid + 1]) - start;
+            break;
+        }
+        if (key < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return true;
+#    else
+    return false;
+#    endif
+}
+
+__attribute__((weak)) bool combo_generated_index_find(uint16_t keycode, const combo_key_ref_t** refs, uint16_t* count) {
+    return combo_generated_index_find_raw(keycode, refs, count);
+}
+
+uint16_t combo_term_raw(uint16_t combo_idx) {
+#    if defined(COMBO_GENERATED_TERMS)
+    _Static_assert(ARRAY_SIZE(combo_terms) == ARRAY_SIZE(key_combos), "Generated combo terms are inconsistent");
+    if (combo_idx < ARRAY_SIZE(combo_terms)) {
+        return pgm_read_word(&combo_terms[combo_idx]);
+    }
+#    endif
+    return COMBO_TERM;
+}
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -66,6 +66,19 @@ combo_t* combo_get_raw(uint16_t combo_idx);
 // Get the combo definition, potentially stored dynamically
 combo_t* combo_get(uint16_t combo_idx);
 
+struct combo_key_ref_t;
+typedef struct combo_key_ref_t combo_key_ref_t;
+
+// Get the combos containing the keycode, from the index generated along with a keymap.json keymap. Returns false if
+// there is no generated index, in which case the combos have to be searched.
+bool combo_generated_index_find_raw(uint16_t keycode, const combo_key_ref_t** refs, uint16_t* count);
+// Get the combos containing the keycode, potentially stored dynamically. Must return false if combo_count() or
+// combo_get() are overridden in a way that the generated index does not describe.
+bool combo_generated_index_find(uint16_t keycode, const combo_key_ref_t** refs, uint16_t* count);
+
+// Get the term of a combo, from the terms generated along with a keymap.json keymap, or COMBO_TERM if it has none
+uint16_t combo_term_raw(uint16_t combo_idx);
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
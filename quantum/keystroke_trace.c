@@ -0,0 +1,158 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keystroke_trace.h"
+#include "timer.h"
+#include "print.h"
+
+#define KEYSTROKE_TRACE_MASK (KEYSTROKE_TRACE_BUFFER_SIZE - 1)
+
+// Written by keystroke_trace_record() at head, read at tail. Both run freely and wrap.
+static uint8_t  buffer[KEYSTROKE_TRACE_BUFFER_SIZE];
+static uint16_t buffer_head = 0;
+static uint16_t buffer_tail = 0;
+
+static bool recording  = false;
+static bool overflowed = false;
+// The clock of the stream after the last record written, and the ticks after it not written yet
+static uint16_t trace_clock = 0;
+static uint8_t  tick_run    = 0;
+
+static uint16_t buffer_free(void) {
+    return KEYSTROKE_TRACE_BUFFER_SIZE - (uint16_t)(buffer_head - buffer_tail);
+}
+
+/* Records are written whole or not at all. Once one is lost, the next to fit is preceded by the overflow marker. */
+static bool write_record(const uint8_t *record, uint8_t length) {
+    if (buffer_free() < length + (overflowed ? 1 : 0)) {
+        overflowed = true;
+        return false;
+    }
+    if (overflowed) {
+        buffer[buffer_head++ & KEYSTROKE_TRACE_MASK] = KEYSTROKE_TRACE_OVERFLOW;
+        overflowed                                   = false;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        buffer[buffer_head++ & KEYSTROKE_TRACE_MASK] = record[i];
+    }
+    return true;
+}
+
+static bool write_ticks(void) {
+    if (tick_run == 0) {
+        return true;
+    }
+    const uint8_t record = KEYSTROKE_TRACE_TICKS(tick_run);
+    const bool    ok     = write_record(&record, 1);
+    if (ok) {
+        trace_clock += tick_run;
+    }
+    tick_run = 0;
+    return ok;
+}
+
+static bool write_time(uint16_t ms) {
+    if (ms == 0) {
+        return true;
+    }
+    bool ok;
+    if (ms < KEYSTROKE_TRACE_TIME_LONG - 0x40) {
+        const uint8_t record = KEYSTROKE_TRACE_TIME(ms);
+        ok                   = write_record(&record, 1);
+    } else {
+        const uint8_t record[] = {KEYSTROKE_TRACE_TIME_LONG, ms & 0xFF, ms >> 8};
+        ok                     = write_record(record, sizeof(record));
+    }
+    if (ok) {
+        trace_clock += ms;
+    }
+    return ok;
+}
+
+void keystroke_trace_start(void) {
+    buffer_head = 0;
+    buffer_tail = 0;
+    overflowed  = false;
+    tick_run    = 0;
+    trace_clock = timer_read();
+    recording   = true;
+
+    const uint8_t header[] = {'Q', 'K', 'T', KEYSTROKE_TRACE_VERSION, trace_clock & 0xFF, trace_clock >> 8};
+    write_record(header, sizeof(header));
+}
+
+void keystroke_trace_stop(void) {
+    if (recording) {
+        write_ticks();
+        recording = false;
+    }
+}
+
+bool keystroke_trace_is_recording(void) {
+    return recording;
+}
+
+void keystroke_trace_record(keyevent_t event) {
+    if (!recording) {
+        return;
+    }
+
+    const uint16_t now = timer_read();
+    if (!IS_EVENT(event)) {
+        // Extend the run of ticks while they keep coming every millisecond
+        if ((uint16_t)(now - trace_clock) == tick_run + 1 && tick_run < KEYSTROKE_TRACE_TICKS_MAX) {
+            tick_run++;
+            return;
+        }
+        if (!write_ticks()) {
+            return;
+        }
+        if (now == trace_clock) {
+            const uint8_t record = KEYSTROKE_TRACE_TICKS(0);
+            write_record(&record, 1);
+        } else if (write_time(now - trace_clock - 1)) {
+            tick_run = 1;
+        }
+        return;
+    }
+
+    if (!write_ticks() || !write_time(now - trace_clock)) {
+        return;
+    }
+    const uint16_t age      = TIMER_DIFF_16(now, event.time);
+    const uint8_t  record[] = {KEYSTROKE_TRACE_EVENT(event.type, event.pressed), event.key.row, event.key.col, age > UINT8_MAX ? UINT8_MAX : age};
+    write_record(record, sizeof(record));
+}
+
+uint16_t keystroke_trace_available(void) {
+    return buffer_head - buffer_tail;
+}
+
+uint16_t keystroke_trace_read(uint8_t *data, uint16_t length) {
+    uint16_t count = 0;
+    while (count < length && buffer_tail != buffer_head) {
+        data[count++] = buffer[buffer_tail++ & KEYSTROKE_TRACE_MASK];
+    }
+    return count;
+}
+
+void keystroke_trace_task(void) {
+#if defined(CONSOLE_ENABLE) && !defined(KEYSTROKE_TRACE_NO_CONSOLE)
+    static uint16_t last_line = 0;
+
+    // Full lines are printed straight away, what is left over once it has waited long enough
+    uint16_t available = keystroke_trace_available();
+    if (available == 0 || (available < KEYSTROKE_TRACE_CONSOLE_LINE && timer_elapsed(last_line) < KEYSTROKE_TRACE_CONSOLE_FLUSH_MS)) {
+        return;
+    }
+
+    uint8_t  line[KEYSTROKE_TRACE_CONSOLE_LINE];
+    uint16_t length = keystroke_trace_read(line, sizeof(line));
+    uprintf("QKT ");
+    for (uint16_t i = 0; i < length; i++) {
+        uprintf("%02X", line[i]);
+    }
+    uprintf("\n");
+    last_line = timer_read();
+#endif
+}
@@ -0,0 +1,94 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+/*
+    Keystroke trace.
+
+    Records every event passed to action_exec(), and the ticks between them, as a compact byte stream that can be
+    replayed on the host by the tests in tests/test_common. The stream is buffered here, and either printed to the
+    console by keystroke_trace_task() or read out by the keyboard, for example over raw HID.
+
+    The stream starts with a header which sets the clock, followed by records which move it on:
+
+        'Q' 'K' 'T' <version> <start time, u16 LE>   header, written by keystroke_trace_start()
+        0b00nnnnnn                                    n ticks, 1ms apart, the first 1ms after the clock, leaving the
+                                                      clock at the last of them; a tick at the clock when n is 0
+        0b01dddddd                                    the clock moved on by d ms without a tick, d < 63
+        0b01111111 <d, u16 LE>                        the same, for any d
+        0b1tttp000 <row> <col> <age>                  an event of type t at the clock, pressed if p, with a time
+                                                      stamp of age ms before the clock
+        0xFF                                          records were lost here because the buffer was full
+*/
+
+#define KEYSTROKE_TRACE_VERSION 1
+
+#define KEYSTROKE_TRACE_TICKS(count) (count)
+#define KEYSTROKE_TRACE_TICKS_MAX 0x3F
+#define KEYSTROKE_TRACE_TIME(ms) (0x40 | (ms))
+#define KEYSTROKE_TRACE_TIME_LONG 0x7F
+#define KEYSTROKE_TRACE_EVENT(type, pressed) (0x80 | ((type) << 4) | ((pressed) ? 0x08 : 0))
+#define KEYSTROKE_TRACE_OVERFLOW 0xFF
+
+#define KEYSTROKE_TRACE_IS_TICKS(record) (((record) & 0xC0) == 0x00)
+#define KEYSTROKE_TRACE_IS_TIME(record) (((record) & 0xC0) == 0x40)
+#define KEYSTROKE_TRACE_IS_EVENT(record) (((record) & 0x80) && (record) != KEYSTROKE_TRACE_OVERFLOW)
+#define KEYSTROKE_TRACE_EVENT_TYPE(record) (((record) >> 4) & 0x07)
+#define KEYSTROKE_TRACE_EVENT_PRESSED(record) (((record) & 0x08) != 0)
+
+// Bytes buffered until they are read or printed, a power of two
+#ifndef KEYSTROKE_TRACE_BUFFER_SIZE
+#    define KEYSTROKE_TRACE_BUFFER_SIZE 256
+#endif
+
+#if KEYSTROKE_TRACE_BUFFER_SIZE < 16 || KEYSTROKE_TRACE_BUFFER_SIZE > 32768 || (KEYSTROKE_TRACE_BUFFER_SIZE & (KEYSTROKE_TRACE_BUFFER_SIZE - 1)) != 0
+#    error KEYSTROKE_TRACE_BUFFER_SIZE must be a power of two between 16 and 32768
+#endif
+
+// Bytes printed per console line
+#ifndef KEYSTROKE_TRACE_CONSOLE_LINE
+#    define KEYSTROKE_TRACE_CONSOLE_LINE 16
+#endif
+
+// Longest time a partial console line is held back, in milliseconds
+#ifndef KEYSTROKE_TRACE_CONSOLE_FLUSH_MS
+#    define KEYSTROKE_TRACE_CONSOLE_FLUSH_MS 100
+#endif
+
+/**
+ * @brief Starts a new trace, discarding anything not yet read from the previous one.
+ */
+void keystroke_trace_start(void);
+
+/**
+ * @brief Stops recording. Anything recorded so far can still be read.
+ */
+void keystroke_trace_stop(void);
+
+bool keystroke_trace_is_recording(void);
+
+/**
+ * @brief Adds an event to the trace. Called by action_exec().
+ */
+void keystroke_trace_record(keyevent_t event);
+
+/**
+ * @brief The number of bytes waiting to be read.
+ */
+uint16_t keystroke_trace_available(void);
+
+/**
+ * @brief Takes up to length bytes of the trace.
+ *
+ * @return the number of bytes copied to data
+ */
+uint16_t keystroke_trace_read(uint8_t *data, uint16_t length);
+
+/**
+ * @brief Prints the trace to the console, unless KEYSTROKE_TRACE_NO_CONSOLE is defined. Called by the core.
+ */
+void keystroke_trace_task(void);
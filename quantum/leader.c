@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "leader.h"
+#include "keyboard.h"
 #include "timer.h"
 #include "util.h"
 
@@ -30,6 +31,7 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+    quantum_task_wake();
 }
 
 void leader_end(void) {
@@ -43,6 +45,19 @@ void leader_task(void) {
     }
 }
 
+uint32_t leader_next_deadline(void) {
+#if defined(LEADER_NO_TIMEOUT)
+    if (!leader_sequence_active() || leader_sequence_size == 0) {
+#else
+    if (!leader_sequence_active()) {
+#endif
+        return UINT32_MAX;
+    }
+
+    uint16_t elapsed = timer_elapsed(leader_time);
+    return elapsed > LEADER_TIMEOUT ? 0 : LEADER_TIMEOUT - elapsed + 1;
+}
+
 bool leader_sequence_active(void) {
     return leading;
 }
@@ -74,6 +89,7 @@ bool leader_sequence_timed_out(void) {
 
 void leader_reset_timer(void) {
     leader_time = timer_read();
+    quantum_task_wake();
 }
 
 bool leader_sequence_is(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5) {
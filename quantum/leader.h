@@ -33,6 +33,11 @@ void leader_end(void);
 
 void leader_task(void);
 
+/**
+ * The number of milliseconds until the leader sequence times out, or `UINT32_MAX` if it cannot time out yet.
+ */
+uint32_t leader_next_deadline(void);
+
 /**
  * Whether the leader sequence is active.
  */
@@ -10,7 +10,7 @@ bool effect_runner_dx_dy_dist(effect_params_t* params, dx_dy_dist_f effect_func)
         LED_MATRIX_TEST_LED_FLAGS();
         int16_t dx   = g_led_config.point[i].x - k_led_matrix_center.x;
         int16_t dy   = g_led_config.point[i].y - k_led_matrix_center.y;
-        uint8_t dist = sqrt16(dx * dx + dy * dy);
+        uint8_t dist = led_matrix_led_distance_from_center(i);
         led_matrix_set_value(i, effect_func(led_matrix_eeconfig.val, dx, dy, dist, time));
     }
     return led_matrix_check_finished_leds(led_max);
@@ -37,6 +37,100 @@ const led_point_t k_led_matrix_center = {112, 32};
 const led_point_t k_led_matrix_center = LED_MATRIX_CENTER;
 #endif
 
+// Only set once checked against the center and points in use, which config.h or keyboard code may have changed
+#ifdef LED_MATRIX_LED_POLAR_TABLE
+static const led_polar_t *led_matrix_polar = NULL;
+#endif
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+static const uint8_t *led_matrix_distances = NULL;
+#endif
+
+#if defined(LED_MATRIX_LED_POLAR_TABLE) || defined(LED_MATRIX_LED_DISTANCE_TABLE)
+__attribute__((weak)) const led_point_t *led_matrix_table_points(void) {
+    return NULL;
+}
+#endif
+
+#ifdef LED_MATRIX_LED_POLAR_TABLE
+__attribute__((weak)) const led_polar_config_t *led_matrix_polar_config(void) {
+    return NULL;
+}
+#endif
+
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+__attribute__((weak)) const uint8_t *led_matrix_distance_table(void) {
+    return NULL;
+}
+#endif
+
+static void led_matrix_init_tables(void) {
+#if defined(LED_MATRIX_LED_POLAR_TABLE) || defined(LED_MATRIX_LED_DISTANCE_TABLE)
+    const led_point_t *points = led_matrix_table_points();
+
+#    ifdef LED_MATRIX_LED_POLAR_TABLE
+    led_matrix_polar = NULL;
+#    endif
+#    ifdef LED_MATRIX_LED_DISTANCE_TABLE
+    led_matrix_distances = NULL;
+#    endif
+    if (points == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        if (pgm_read_byte(&points[i].x) != g_led_config.point[i].x || pgm_read_byte(&points[i].y) != g_led_config.point[i].y) {
+            return;
+        }
+    }
+
+    // Each table only depends on the points, and the polar table on the center too
+#    ifdef LED_MATRIX_LED_DISTANCE_TABLE
+    led_matrix_distances = led_matrix_distance_table();
+#    endif
+#    ifdef LED_MATRIX_LED_POLAR_TABLE
+    const led_polar_config_t *config = led_matrix_polar_config();
+    if (config != NULL && pgm_read_byte(&config->center.x) == k_led_matrix_center.x && pgm_read_byte(&config->center.y) == k_led_matrix_center.y) {
+        led_matrix_polar = config->polar;
+    }
+#    endif
+#endif
+}
+
+led_polar_t led_matrix_led_polar(uint8_t index) {
+#ifdef LED_MATRIX_LED_POLAR_TABLE
+    if (led_matrix_polar) {
+        return (led_polar_t){pgm_read_byte(&led_matrix_polar[index].angle), pgm_read_byte(&led_matrix_polar[index].dist)};
+    }
+#endif
+    int16_t dx = g_led_config.point[index].x - k_led_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_led_matrix_center.y;
+    return (led_polar_t){atan2_8(dy, dx), sqrt16(dx * dx + dy * dy)};
+}
+
+uint8_t led_matrix_led_distance_from_center(uint8_t index) {
+#ifdef LED_MATRIX_LED_POLAR_TABLE
+    if (led_matrix_polar) {
+        return pgm_read_byte(&led_matrix_polar[index].dist);
+    }
+#endif
+    int16_t dx = g_led_config.point[index].x - k_led_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_led_matrix_center.y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
+uint8_t led_matrix_led_distance(uint8_t led_a, uint8_t led_b) {
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+    if (led_matrix_distances) {
+        if (led_a == led_b) {
+            return 0;
+        }
+        return pgm_read_byte(&led_matrix_distances[led_distance_index(led_a, led_b)]);
+    }
+#endif
+    int16_t dx = g_led_config.point[led_a].x - g_led_config.point[led_b].x;
+    int16_t dy = g_led_config.point[led_a].y - g_led_config.point[led_b].y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
 // Generic effect runners
 #include "led_matrix_runners.inc"
 
@@ -309,13 +403,25 @@ static void led_task_flush(uint8_t effect) {
     led_last_enable = led_matrix_eeconfig.enable;
 
     // update pwm buffers
+#ifdef LED_MATRIX_ASYNC_FLUSH
+    // only queue the writes, led_matrix_task() sends them while the keyboard keeps scanning
+    led_flush_queue_defer(true);
+    led_matrix_update_pwm_buffers();
+    led_flush_queue_defer(false);
+#else
     led_matrix_update_pwm_buffers();
+#endif
 
     // next task
     led_task_state = SYNCING;
 }
 
 void led_matrix_task(void) {
+#ifdef LED_MATRIX_ASYNC_FLUSH
+    // send the next write of the last frame flushed
+    led_flush_queue_task();
+#endif
+
     led_task_timers();
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
@@ -342,6 +448,10 @@ void led_matrix_task(void) {
             }
             break;
         case FLUSHING:
+#ifdef LED_MATRIX_ASYNC_FLUSH
+            // the last frame has to be sent first, so that the queue only ever holds one
+            if (led_flush_queue_busy()) break;
+#endif
             led_task_flush(effect);
             break;
         case SYNCING:
@@ -412,6 +522,7 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
 
 void led_matrix_init(void) {
     led_matrix_driver.init();
+    led_matrix_init_tables();
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -438,6 +549,9 @@ void led_matrix_set_suspend_state(bool state) {
     if (state && !suspend_state && is_keyboard_master()) { // only run if turning off, and only once
         led_task_render(0);                                // turn off all LEDs when suspending
         led_task_flush(0);                                 // and actually flash led state to LEDs
+#ifdef LED_MATRIX_ASYNC_FLUSH
+        led_flush_queue_wait();
+#endif
     }
     suspend_state = state;
 #endif
@@ -176,6 +176,23 @@ led_flags_t led_matrix_get_flags(void);
 void        led_matrix_set_flags(led_flags_t flags);
 void        led_matrix_set_flags_noeeprom(led_flags_t flags);
 
+/* Angle and distance of an LED from the center, from the generated table when LED_MATRIX_LED_POLAR_TABLE is defined and it matches the LED layout */
+led_polar_t led_matrix_led_polar(uint8_t index);
+/* Distance of an LED from the center, from the same table as led_matrix_led_polar() but without working out the angle when it is not in use */
+uint8_t led_matrix_led_distance_from_center(uint8_t index);
+/* Distance between two LEDs, from the generated table when LED_MATRIX_LED_DISTANCE_TABLE is defined and it matches the LED layout */
+uint8_t led_matrix_led_distance(uint8_t led_a, uint8_t led_b);
+/* The tables generated from info.json, see lib/python/qmk/cli/generate/keyboard_c.py, and the points they were computed from */
+#if defined(LED_MATRIX_LED_POLAR_TABLE) || defined(LED_MATRIX_LED_DISTANCE_TABLE)
+const led_point_t *led_matrix_table_points(void);
+#endif
+#ifdef LED_MATRIX_LED_POLAR_TABLE
+const led_polar_config_t *led_matrix_polar_config(void);
+#endif
+#ifdef LED_MATRIX_LED_DISTANCE_TABLE
+const uint8_t *led_matrix_distance_table(void);
+#endif
+
 static inline bool led_matrix_check_finished_leds(uint8_t led_idx) {
 #if defined(LED_MATRIX_SPLIT)
     if (is_keyboard_left()) {
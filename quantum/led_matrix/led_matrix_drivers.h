@@ -33,6 +33,13 @@
 #    include "snled27351-mono.h"
 #endif
 
+#ifdef LED_MATRIX_ASYNC_FLUSH
+#    if !(defined(LED_MATRIX_IS31FL3729) || defined(LED_MATRIX_IS31FL3731) || defined(LED_MATRIX_IS31FL3733) || defined(LED_MATRIX_IS31FL3736) || defined(LED_MATRIX_IS31FL3737) || defined(LED_MATRIX_IS31FL3741) || defined(LED_MATRIX_IS31FL3742A) || defined(LED_MATRIX_IS31FL3743A) || defined(LED_MATRIX_IS31FL3745) || defined(LED_MATRIX_IS31FL3746A) || defined(LED_MATRIX_SNLED27351))
+#        error "LED_MATRIX_ASYNC_FLUSH is only supported by the IS31FL37xx and SNLED27351 drivers"
+#    endif
+#    include "led_flush_queue.h"
+#endif
+
 typedef struct {
     /* Perform any initialisation required for the other driver functions to work. */
     void (*init)(void);
@@ -72,6 +72,18 @@ int main(void) {
         deferred_exec_task();
 #endif // DEFERRED_EXEC_ENABLE
 
+#ifdef PROFILER_ENABLE
+        // Drain and report profiler samples
+        void profiler_task(void);
+        profiler_task();
+#endif // PROFILER_ENABLE
+
+#ifdef MATRIX_IDLE_ENABLE
+        // Sleep until the next deadline if the matrix is idle
+        void matrix_idle_task(void);
+        matrix_idle_task();
+#endif // MATRIX_IDLE_ENABLE
+
         housekeeping_task();
     }
 }
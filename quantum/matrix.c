@@ -62,6 +62,19 @@ static SPLIT_MUTABLE_COL pin_t col_pins[MATRIX_COLS]   = MATRIX_COL_PINS;
 #    endif // MATRIX_COL_PINS
 #endif
 
+// Column pins grouped by port, generated when info.json sets `matrix_pins.port_reads`
+#if !defined(DIRECT_PINS) && (DIODE_DIRECTION == COL2ROW) && defined(MATRIX_COL_PORT_PINS) && defined(MATRIX_COL_PORT_RUNS) && defined(gpio_read_port) && !defined(MATRIX_COL_PINS_RIGHT)
+#    define MATRIX_COL_PORT_READS
+typedef struct {
+    uint8_t  port;  // index into col_port_pins
+    int8_t   shift; // column minus pad, the same for every pad in the run
+    uint32_t mask;  // pads of the port in the run
+} matrix_col_run_t;
+
+static const pin_t            col_port_pins[] = MATRIX_COL_PORT_PINS;
+static const matrix_col_run_t col_runs[]      = MATRIX_COL_PORT_RUNS;
+#endif
+
 /* matrix state(1:on, 0:off) */
 extern matrix_row_t raw_matrix[MATRIX_ROWS]; // raw values
 extern matrix_row_t matrix[MATRIX_ROWS];     // debounced values
@@ -181,6 +194,25 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_COL_PORT_READS
+    // Read each port once...
+    uint32_t pressed[ARRAY_SIZE(col_port_pins)];
+    for (uint8_t port_index = 0; port_index < ARRAY_SIZE(col_port_pins); port_index++) {
+#                if MATRIX_INPUT_PRESSED_STATE == 0
+        pressed[port_index] = ~(uint32_t)gpio_read_port(col_port_pins[port_index]);
+#                else
+        pressed[port_index] = gpio_read_port(col_port_pins[port_index]);
+#                endif
+    }
+
+    // ...then move each run of pads into place
+    for (uint8_t run_index = 0; run_index < ARRAY_SIZE(col_runs); run_index++) {
+        const matrix_col_run_t *run  = &col_runs[run_index];
+        uint32_t                pads = pressed[run->port] & run->mask;
+
+        current_row_value |= (matrix_row_t)(run->shift >= 0 ? pads << run->shift : pads >> -run->shift);
+    }
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -189,6 +221,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
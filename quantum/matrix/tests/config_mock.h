@@ -0,0 +1,50 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 6
+#define MATRIX_COLS 20
+#define DIODE_DIRECTION COL2ROW
+#define IGNORE_ATOMIC_BLOCK
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock_gpio.h"
+
+#ifdef __cplusplus
+};
+#endif
+
+/* Ports A to D, spread so that columns are in order, reversed, split across ports, or missing */
+#define A0 MOCK_PIN(0, 0)
+#define A1 MOCK_PIN(0, 1)
+#define A2 MOCK_PIN(0, 2)
+#define A3 MOCK_PIN(0, 3)
+#define A4 MOCK_PIN(0, 4)
+#define A5 MOCK_PIN(0, 5)
+#define A6 MOCK_PIN(0, 6)
+#define A7 MOCK_PIN(0, 7)
+#define A8 MOCK_PIN(0, 8)
+#define A31 MOCK_PIN(0, 31)
+#define B4 MOCK_PIN(1, 4)
+#define B5 MOCK_PIN(1, 5)
+#define B6 MOCK_PIN(1, 6)
+#define B7 MOCK_PIN(1, 7)
+#define B12 MOCK_PIN(1, 12)
+#define B13 MOCK_PIN(1, 13)
+#define B14 MOCK_PIN(1, 14)
+#define B15 MOCK_PIN(1, 15)
+#define C0 MOCK_PIN(2, 0)
+#define D0 MOCK_PIN(3, 0)
+#define D1 MOCK_PIN(3, 1)
+#define D2 MOCK_PIN(3, 2)
+#define D3 MOCK_PIN(3, 3)
+#define D4 MOCK_PIN(3, 4)
+#define D5 MOCK_PIN(3, 5)
+
+#define MATRIX_ROW_PINS \
+    { D0, D1, D2, D3, D4, D5 }
+#define MATRIX_COL_PINS \
+    { A0, A1, A2, A3, A4, A5, A6, A7, B12, B13, B14, B15, B7, B6, B5, B4, C0, NO_PIN, A8, A31 }
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+#include "config_mock.h"
+
+/* As generated from `"matrix_pins": {"port_reads": true}` for the pins in config_mock.h */
+#define MATRIX_COL_PORT_PINS \
+    { A0, B12, C0 }
+#define MATRIX_COL_PORT_RUNS \
+    { { 0, 0, 0x000000FF }, { 1, -4, 0x0000F000 }, { 1, 5, 0x00000080 }, { 1, 7, 0x00000040 }, { 1, 9, 0x00000020 }, { 1, 11, 0x00000010 }, { 2, 16, 0x00000001 }, { 0, 10, 0x00000100 }, { 0, -12, 0x80000000 } }
@@ -0,0 +1,145 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark_util.hpp"
+
+#include <random>
+
+extern "C" {
+#include "matrix.h"
+
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
+
+void matrix_init_kb(void) {}
+void matrix_scan_kb(void) {}
+void matrix_output_select_delay(void) {}
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {}
+}
+
+#ifdef MATRIX_COL_PORT_PINS
+#    define MATRIX_READS "port_reads"
+#else
+#    define MATRIX_READS "pin_reads"
+#endif
+
+/* The same tests run against the per-pin reads and the port reads, which must agree with the switches */
+
+class Matrix : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+        const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+        mock_gpio_reset();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (col_pins[col] != NO_PIN) {
+                    switches_[row][col] = mock_gpio_add_switch(row_pins[row], col_pins[col]);
+                    connected_[row] |= MATRIX_ROW_SHIFTER << col;
+                }
+            }
+        }
+        matrix_init();
+    }
+
+    void set_key(uint8_t row, uint8_t col, bool pressed) {
+        if (connected_[row] & (MATRIX_ROW_SHIFTER << col)) {
+            mock_gpio_set_switch(switches_[row][col], pressed);
+            expected_[row] = pressed ? expected_[row] | (MATRIX_ROW_SHIFTER << col) : expected_[row] & ~(MATRIX_ROW_SHIFTER << col);
+        }
+    }
+
+    void set_random_keys(std::mt19937 &rng, unsigned percent) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                set_key(row, col, rng() % 100 < percent);
+            }
+        }
+    }
+
+    void expect_matrix() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(raw_matrix[row], expected_[row]) << "row " << (int)row;
+        }
+    }
+
+    uint16_t     switches_[MATRIX_ROWS][MATRIX_COLS] = {};
+    matrix_row_t connected_[MATRIX_ROWS]             = {};
+    matrix_row_t expected_[MATRIX_ROWS]              = {};
+};
+
+TEST_F(Matrix, ReadsEachKey) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            set_key(row, col, true);
+            matrix_scan();
+            expect_matrix();
+            set_key(row, col, false);
+        }
+    }
+    matrix_scan();
+    expect_matrix();
+}
+
+TEST_F(Matrix, ReadsRandomKeys) {
+    std::mt19937 rng(2026);
+
+    for (int i = 0; i < 500; i++) {
+        set_random_keys(rng, i % 2 ? 10 : 60);
+        matrix_scan();
+        expect_matrix();
+    }
+}
+
+TEST_F(Matrix, GpioReadsPerScan) {
+    matrix_scan();
+
+#ifdef MATRIX_COL_PORT_PINS
+    const pin_t col_port_pins[] = MATRIX_COL_PORT_PINS;
+    EXPECT_EQ(mock_gpio_port_reads, MATRIX_ROWS * sizeof(col_port_pins) / sizeof(col_port_pins[0]));
+    EXPECT_EQ(mock_gpio_pin_reads, 0);
+#else
+    EXPECT_EQ(mock_gpio_port_reads, 0);
+    // Every column but the one without a pin
+    EXPECT_EQ(mock_gpio_pin_reads, MATRIX_ROWS * (MATRIX_COLS - 1));
+#endif
+}
+
+TEST_F(Matrix, Benchmark) {
+    std::mt19937    rng(2026);
+    BenchmarkSeries scans;
+
+    mock_gpio_pin_reads  = 0;
+    mock_gpio_port_reads = 0;
+    for (int i = 0; i < 20000; i++) {
+        if (i % 100 == 0) {
+            set_random_keys(rng, 5);
+        }
+        BenchmarkStopwatch stopwatch;
+        matrix_scan();
+        scans.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+    }
+    expect_matrix();
+
+    BenchmarkReport report("matrix." MATRIX_READS ".scan");
+    report.add("rows", MATRIX_ROWS);
+    report.add("cols", MATRIX_COLS);
+    report.add("gpio_reads_per_scan", (mock_gpio_pin_reads + mock_gpio_port_reads) / scans.count());
+    report.add_series("scan", scans);
+    report.emit();
+}
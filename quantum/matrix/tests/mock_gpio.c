@@ -0,0 +1,130 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mock_gpio.h"
+
+#include <string.h>
+
+#define MOCK_GPIO_MAX_SWITCHES 1024
+
+typedef struct {
+    pin_t a;
+    pin_t b;
+    bool  closed;
+} mock_gpio_switch_t;
+
+/* One bit per pad */
+static uint32_t           pull_ups[MOCK_GPIO_PORTS];
+static uint32_t           outputs[MOCK_GPIO_PORTS];
+static uint32_t           output_levels[MOCK_GPIO_PORTS];
+static mock_gpio_switch_t switches[MOCK_GPIO_MAX_SWITCHES];
+static uint16_t           switch_count;
+
+/* Input registers, worked out again on the first read after a change */
+static uint32_t port_levels[MOCK_GPIO_PORTS];
+static bool     levels_dirty;
+
+uint32_t mock_gpio_pin_reads;
+uint32_t mock_gpio_port_reads;
+
+#define PORT(pin) ((pin) / MOCK_GPIO_PADS)
+#define BIT(pin) ((uint32_t)1 << ((pin) % MOCK_GPIO_PADS))
+
+static bool driven_low(pin_t pin) {
+    return (outputs[PORT(pin)] & ~output_levels[PORT(pin)] & BIT(pin)) != 0;
+}
+
+static bool pulled_up(pin_t pin) {
+    return (pull_ups[PORT(pin)] & BIT(pin)) != 0;
+}
+
+static void update_levels(void) {
+    // Inputs without a pull-up read the reset value of the input register
+    for (uint8_t port = 0; port < MOCK_GPIO_PORTS; port++) {
+        port_levels[port] = pull_ups[port] | (outputs[port] & output_levels[port]);
+    }
+    for (uint16_t i = 0; i < switch_count; i++) {
+        const mock_gpio_switch_t *sw = &switches[i];
+        if (!sw->closed) {
+            continue;
+        }
+        if (pulled_up(sw->a) && driven_low(sw->b)) {
+            port_levels[PORT(sw->a)] &= ~BIT(sw->a);
+        }
+        if (pulled_up(sw->b) && driven_low(sw->a)) {
+            port_levels[PORT(sw->b)] &= ~BIT(sw->b);
+        }
+    }
+    levels_dirty = false;
+}
+
+static uint32_t read_port(pin_t pin) {
+    if (levels_dirty) {
+        update_levels();
+    }
+    return port_levels[PORT(pin)];
+}
+
+void mock_gpio_reset(void) {
+    memset(pull_ups, 0, sizeof(pull_ups));
+    memset(outputs, 0, sizeof(outputs));
+    memset(output_levels, 0, sizeof(output_levels));
+    switch_count         = 0;
+    levels_dirty         = true;
+    mock_gpio_pin_reads  = 0;
+    mock_gpio_port_reads = 0;
+}
+
+uint16_t mock_gpio_add_switch(pin_t a, pin_t b) {
+    switches[switch_count] = (mock_gpio_switch_t){.a = a, .b = b, .closed = false};
+    return switch_count++;
+}
+
+void mock_gpio_set_switch(uint16_t index, bool closed) {
+    switches[index].closed = closed;
+    levels_dirty           = true;
+}
+
+void mock_gpio_set_pin_input_high(pin_t pin) {
+    pull_ups[PORT(pin)] |= BIT(pin);
+    outputs[PORT(pin)] &= ~BIT(pin);
+    levels_dirty = true;
+}
+
+void mock_gpio_set_pin_output(pin_t pin) {
+    pull_ups[PORT(pin)] &= ~BIT(pin);
+    outputs[PORT(pin)] |= BIT(pin);
+    levels_dirty = true;
+}
+
+void mock_gpio_write_pin(pin_t pin, bool level) {
+    if (level) {
+        output_levels[PORT(pin)] |= BIT(pin);
+    } else {
+        output_levels[PORT(pin)] &= ~BIT(pin);
+    }
+    levels_dirty = true;
+}
+
+bool mock_gpio_read_pin(pin_t pin) {
+    mock_gpio_pin_reads++;
+    return (read_port(pin) & BIT(pin)) != 0;
+}
+
+uint32_t mock_gpio_read_port(pin_t pin) {
+    mock_gpio_port_reads++;
+    return read_port(pin);
+}
@@ -0,0 +1,54 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Host GPIO with MOCK_GPIO_PORTS ports of 32 pads each. Switches connect pairs of pins: an input with its pull-up
+ * enabled reads low while a closed switch connects it to an output driven low.
+ */
+
+typedef uint8_t pin_t;
+
+#define MOCK_GPIO_PORTS 4
+#define MOCK_GPIO_PADS 32
+#define MOCK_PIN(port, pad) ((pin_t)(((port) << 5) | (pad)))
+
+#define gpio_set_pin_input_high(pin) mock_gpio_set_pin_input_high(pin)
+#define gpio_set_pin_output(pin) mock_gpio_set_pin_output(pin)
+#define gpio_write_pin_high(pin) mock_gpio_write_pin(pin, true)
+#define gpio_write_pin_low(pin) mock_gpio_write_pin(pin, false)
+#define gpio_read_pin(pin) mock_gpio_read_pin(pin)
+#define gpio_read_port(pin) mock_gpio_read_port(pin)
+
+void     mock_gpio_set_pin_input_high(pin_t pin);
+void     mock_gpio_set_pin_output(pin_t pin);
+void     mock_gpio_write_pin(pin_t pin, bool level);
+bool     mock_gpio_read_pin(pin_t pin);
+uint32_t mock_gpio_read_port(pin_t pin);
+
+/* Forgets every pin mode, level and switch, and clears the read counters */
+void mock_gpio_reset(void);
+/* Adds a switch between two pins, returning its index */
+uint16_t mock_gpio_add_switch(pin_t a, pin_t b);
+void     mock_gpio_set_switch(uint16_t index, bool closed);
+
+/* GPIO reads since the last reset */
+extern uint32_t mock_gpio_pin_reads;
+extern uint32_t mock_gpio_port_reads;
@@ -0,0 +1,17 @@
+matrix_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+matrix_INC := $(ROOT_DIR)tests/test_common
+
+matrix_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock_gpio.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_port_reads_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock_port_reads.h
+matrix_port_reads_INC := $(ROOT_DIR)tests/test_common
+
+matrix_port_reads_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock_gpio.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix.c
@@ -0,0 +1,3 @@
+TEST_LIST += \
+	matrix \
+	matrix_port_reads
@@ -0,0 +1,123 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix_idle.h"
+#include "quantum.h"
+
+#ifdef SPLIT_KEYBOARD
+#    error "MATRIX_IDLE_ENABLE is not supported on split keyboards, as the matrix scan also drives the split transport."
+#endif
+
+static bool          idle        = false;
+static bool          wake_armed  = false;
+static volatile bool wake_needed = false;
+static uint16_t      idle_start  = 0;
+
+__attribute__((weak)) bool matrix_idle_arm(void) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_idle_disarm(void) {}
+
+__attribute__((weak)) void matrix_idle_sleep(uint32_t timeout_ms) {}
+
+__attribute__((weak)) uint32_t matrix_idle_deadline_user(void) {
+    return UINT32_MAX;
+}
+
+__attribute__((weak)) uint32_t matrix_idle_deadline_kb(void) {
+    return matrix_idle_deadline_user();
+}
+
+static inline uint32_t min_deadline(uint32_t a, uint32_t b) {
+    return a < b ? a : b;
+}
+
+/** \brief Time until the tapping state machine or a one shot timeout needs a tick event, which only matrix_task()
+ * generates
+ */
+static uint32_t tick_deadline(void) {
+#if !defined(NO_ACTION_ONESHOT) && defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0)
+    if (get_oneshot_mods() || get_oneshot_layer_state()) {
+        return 0;
+    }
+#endif
+#ifndef NO_ACTION_TAPPING
+    return action_tapping_next_deadline();
+#else
+    return UINT32_MAX;
+#endif
+}
+
+static bool any_key_pressed(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void enter_idle(void) {
+    idle       = true;
+    idle_start = timer_read();
+    wake_armed = matrix_idle_arm();
+}
+
+static void leave_idle(void) {
+    idle        = false;
+    wake_needed = false;
+    matrix_idle_disarm();
+}
+
+bool matrix_idle_should_scan(void) {
+    if (!idle) {
+        if (last_matrix_activity_elapsed() < MATRIX_IDLE_TIMEOUT || any_key_pressed() || tick_deadline() == 0) {
+            return true;
+        }
+        enter_idle();
+    }
+
+    if (wake_needed || tick_deadline() == 0 || (!wake_armed && timer_elapsed(idle_start) >= MATRIX_IDLE_POLL_INTERVAL)) {
+        // Scanning resumes for at least one pass; idle is re-entered straight afterwards if nothing changed
+        leave_idle();
+        return true;
+    }
+
+    return false;
+}
+
+bool matrix_idle_is_idle(void) {
+    return idle;
+}
+
+void matrix_idle_wake(void) {
+    wake_needed = true;
+}
+
+uint32_t matrix_idle_next_deadline(void) {
+    // Everything keyboard_task() waits on: the quantum feature tasks, tapping, one shot timeouts and queued key events
+    uint32_t deadline = min_deadline(keyboard_task_next_deadline(), matrix_idle_deadline_kb());
+
+    if (idle && !wake_armed) {
+        uint16_t elapsed = timer_elapsed(idle_start);
+        deadline         = min_deadline(deadline, elapsed >= MATRIX_IDLE_POLL_INTERVAL ? 0 : MATRIX_IDLE_POLL_INTERVAL - elapsed);
+    }
+#ifdef DEFERRED_EXEC_ENABLE
+    // Run from the main loop rather than keyboard_task()
+    deadline = min_deadline(deadline, deferred_exec_next_deadline());
+#endif
+
+    return deadline;
+}
+
+void matrix_idle_task(void) {
+    if (!idle || wake_needed) {
+        return;
+    }
+
+    uint32_t timeout = matrix_idle_next_deadline();
+    if (timeout > 0) {
+        matrix_idle_sleep(timeout);
+    }
+}
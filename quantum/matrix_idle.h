@@ -0,0 +1,86 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Idle matrix scanning.
+
+    Once every key has been released, nothing has changed for MATRIX_IDLE_TIMEOUT milliseconds, and the tapping state
+    machine has nothing left to resolve, matrix_task() stops scanning the matrix and stops generating tick events. The
+    matrix is scanned again when one of the following happens:
+
+    - the keyboard reports a column edge by calling matrix_idle_wake(), usually from a pin interrupt armed in
+      matrix_idle_arm()
+    - MATRIX_IDLE_POLL_INTERVAL milliseconds have passed, if matrix_idle_arm() could not arm a wake source
+    - the tapping state machine needs a tick to time out a pending key
+
+    While idle, the main loop calls matrix_idle_sleep() with the time until the next known deadline.
+*/
+
+#ifndef MATRIX_IDLE_TIMEOUT
+#    define MATRIX_IDLE_TIMEOUT 100
+#endif
+
+#ifndef MATRIX_IDLE_POLL_INTERVAL
+#    define MATRIX_IDLE_POLL_INTERVAL 10
+#endif
+
+/**
+ * @brief Decides whether matrix_task() should scan the matrix on this pass of the main loop.
+ *
+ * Called by the core; also moves into and out of the idle state.
+ */
+bool matrix_idle_should_scan(void);
+
+/**
+ * @brief Sleeps until the next deadline if the matrix is idle. Called by the core once per pass of the main loop.
+ */
+void matrix_idle_task(void);
+
+/**
+ * @brief Whether matrix scanning is currently suspended.
+ */
+bool matrix_idle_is_idle(void);
+
+/**
+ * @brief Requests a matrix scan on the next pass of the main loop. Safe to call from an interrupt handler.
+ */
+void matrix_idle_wake(void);
+
+/**
+ * @brief Queries how long the keyboard may sleep before something needs servicing.
+ *
+ * Combines the deadlines of deferred executors, the tapping state machine, combos, tap dances, the idle poll
+ * interval, and matrix_idle_deadline_kb().
+ *
+ * @return the number of milliseconds until the next deadline, 0 if one is already due, or UINT32_MAX if there is none
+ */
+uint32_t matrix_idle_next_deadline(void);
+
+/**
+ * @brief Arms a wake source, such as an edge interrupt on the column pins, for when the matrix goes idle.
+ *
+ * Implementations should call matrix_idle_wake() if a key is already down once armed, so that a press which raced
+ * the arming is not lost.
+ *
+ * @return true if matrix_idle_wake() will be called on a key press, false to fall back to polling
+ */
+bool matrix_idle_arm(void);
+
+/**
+ * @brief Disarms the wake source when scanning resumes.
+ */
+void matrix_idle_disarm(void);
+
+/**
+ * @brief Puts the MCU to sleep for at most the given number of milliseconds. Does nothing by default.
+ *
+ * Implementations must return early when an interrupt arrives.
+ */
+void matrix_idle_sleep(uint32_t timeout_ms);
+
+uint32_t matrix_idle_deadline_kb(void);
+uint32_t matrix_idle_deadline_user(void);
@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -26,6 +27,14 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "progmem.h"
+
+#ifdef KEY_EVENT_QUEUE_ENABLE
+// Queued key events carry the time of the scan that found them, so time combos from the press itself
+#    define COMBO_PRESS_TIME(record) ((record)->event.time)
+#else
+#    define COMBO_PRESS_TIME(record) timer_read()
+#endif
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -49,7 +58,7 @@ __attribute__((weak)) bool get_combo_must_tap(uint16_t index, combo_t *combo) {
 
 #ifdef COMBO_TERM_PER_COMBO
 __attribute__((weak)) uint16_t get_combo_term(uint16_t index, combo_t *combo) {
-    return COMBO_TERM;
+    return combo_term_raw(index);
 }
 #endif
 
@@ -141,6 +150,92 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
         } while (0)
 #endif
 
+#if COMBO_INDEX_SIZE > 0
+/* Index from keycode to the combos containing it, sorted by keycode and then
+ * combo index, so that a key event only visits the combos it can affect. Each
+ * combo visited is marked in combo_index_touched, so that clear_combos() only
+ * has to reset those. The index is built on first use, and rebuilt whenever the
+ * number of combos changes or combo_index_invalidate() is called. If the combos
+ * do not fit, every combo is checked on each event instead. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+
+static combo_index_entry_t combo_index[COMBO_INDEX_SIZE];
+static uint8_t             combo_index_touched[(COMBO_INDEX_SIZE + 7) / 8];
+static uint16_t            combo_index_entries = 0;
+static uint16_t            combo_index_combos  = 0;
+static bool                combo_index_stale   = true;
+static bool                combo_index_usable  = false;
+
+void combo_index_invalidate(void) {
+    combo_index_stale = true;
+}
+
+static void combo_index_build(void) {
+    uint16_t count      = combo_count();
+    combo_index_stale   = false;
+    combo_index_usable  = false;
+    combo_index_combos  = count;
+    combo_index_entries = 0;
+    if (count > COMBO_INDEX_SIZE) {
+        return;
+    }
+
+    for (uint16_t idx = 0; idx < count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            // A key listed twice in one combo only needs one entry
+            bool seen = false;
+            for (uint8_t j = 0; j < i && !seen; ++j) {
+                seen = pgm_read_word(&keys[j]) == key;
+            }
+            if (seen) {
+                continue;
+            }
+            if (combo_index_entries == COMBO_INDEX_SIZE) {
+                return;
+            }
+
+            // Insertion sort, keeping combos sharing a key in index order
+            uint16_t pos = combo_index_entries++;
+            while (pos > 0 && combo_index[pos - 1].keycode > key) {
+                combo_index[pos] = combo_index[pos - 1];
+                pos--;
+            }
+            combo_index[pos] = (combo_index_entry_t){.keycode = key, .combo_index = idx};
+        }
+    }
+
+    // Any combo may be mid-chord when the index is rebuilt
+    memset(combo_index_touched, 0xFF, sizeof(combo_index_touched));
+    combo_index_usable = true;
+}
+
+static inline bool combo_index_ready(void) {
+    if (combo_index_stale || combo_index_combos != combo_count()) {
+        combo_index_build();
+    }
+    return combo_index_usable;
+}
+
+static uint16_t combo_index_find(uint16_t keycode) {
+    // First entry for the keycode, if any
+    uint16_t low = 0, high = combo_index_entries;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 static inline void release_combo(uint16_t combo_index, combo_t *combo) {
     if (combo->keycode) {
         keyrecord_t record = {
@@ -194,6 +289,24 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#if COMBO_INDEX_SIZE > 0
+    if (combo_index_ready()) {
+        for (uint16_t byte = 0; byte < (combo_index_combos + 7) / 8; ++byte) {
+            for (uint8_t bit = 0; combo_index_touched[byte] >> bit; ++bit) {
+                index = byte * 8 + bit;
+                if (!(combo_index_touched[byte] & (1 << bit)) || index >= combo_index_combos) {
+                    continue;
+                }
+                combo_t *combo = combo_get(index);
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    combo_index_touched[byte] &= ~(1 << bit);
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -256,7 +369,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -414,16 +526,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
-
+static bool process_combo_key(combo_t *combo, uint16_t combo_index, uint16_t key_index, uint8_t key_count, uint16_t keycode, keyrecord_t *record) {
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -534,9 +637,21 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return false;
+    }
+
+    return process_combo_key(combo, combo_index, key_index, key_count, keycode, record);
+}
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +679,36 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+    const combo_key_ref_t *refs;
+    uint16_t               ref_count;
+    if (combo_generated_index_find(keycode, &refs, &ref_count)) {
+        // The generated index also records where the key is in each combo
+        for (uint16_t i = 0; i < ref_count; ++i) {
+            combo_key_ref_t ref;
+            memcpy_P(&ref, &refs[i], sizeof(ref));
+#if COMBO_INDEX_SIZE > 0
+            // clear_combos() only relies on the touched combos while the runtime index is usable, which needs every
+            // combo to fit in it
+            if (ref.combo_index < COMBO_INDEX_SIZE) {
+                combo_index_touched[ref.combo_index / 8] |= 1 << (ref.combo_index % 8);
+            }
+#endif
+            is_combo_key |= process_combo_key(combo_get(ref.combo_index), ref.combo_index, ref.key_index, ref.key_count, keycode, record);
+        }
+    }
+#if COMBO_INDEX_SIZE > 0
+    else if (combo_index_ready()) {
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_entries && combo_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_index[i].combo_index;
+            combo_index_touched[idx / 8] |= 1 << (idx % 8);
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    }
+#endif
+    else {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -575,10 +716,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_STRICT_TIMER
         if (!timer) {
             // timer is set only on the first key
-            timer = timer_read();
+            timer = COMBO_PRESS_TIME(record);
         }
 #    else
-        timer = timer_read();
+        timer = COMBO_PRESS_TIME(record);
 #    endif
 #endif
 
@@ -625,6 +766,17 @@ void combo_task(void) {
 #endif
 }
 
+uint32_t combo_next_deadline(void) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        uint16_t elapsed = timer_elapsed(timer);
+        // combo_task() fires once the elapsed time exceeds the longest term
+        return elapsed > longest_term ? 0 : longest_term - elapsed + 1;
+    }
+#endif
+    return UINT32_MAX;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
@@ -38,6 +38,9 @@
 #ifndef COMBO_BUFFER_LENGTH
 #    define COMBO_BUFFER_LENGTH 4
 #endif
+#ifndef COMBO_INDEX_SIZE
+#    define COMBO_INDEX_SIZE 0
+#endif
 
 typedef struct combo_t {
     const uint16_t *keys;
@@ -57,6 +60,13 @@ typedef struct combo_t {
 #endif
 } combo_t;
 
+/* Where a key appears in a combo, as listed in the combo index generated from keymap.json */
+typedef struct combo_key_ref_t {
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_key_ref_t;
+
 #define COMBO(ck, ca) \
     { .keys = &(ck)[0], .keycode = (ca) }
 #define COMBO_ACTION(ck) \
@@ -73,11 +83,16 @@ typedef struct combo_t {
 /* check if keycode is only modifiers */
 #define KEYCODE_IS_MOD(code) (IS_MODIFIER_KEYCODE(code) || (IS_QK_MODS(code) && !QK_MODS_GET_BASIC_KEYCODE(code)))
 
-bool process_combo(uint16_t keycode, keyrecord_t *record);
-void combo_task(void);
-void process_combo_event(uint16_t combo_index, bool pressed);
+bool     process_combo(uint16_t keycode, keyrecord_t *record);
+void     combo_task(void);
+uint32_t combo_next_deadline(void);
+void     process_combo_event(uint16_t combo_index, bool pressed);
 
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#if COMBO_INDEX_SIZE > 0
+void combo_index_invalidate(void);
+#endif
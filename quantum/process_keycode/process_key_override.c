@@ -405,6 +405,15 @@ void key_override_task(void) {
     }
 }
 
+uint32_t key_override_next_deadline(void) {
+    if (deferred_register == 0) {
+        return UINT32_MAX;
+    }
+
+    uint32_t elapsed = timer_elapsed32(defer_reference_time);
+    return elapsed >= defer_delay ? 0 : defer_delay - elapsed;
+}
+
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
 #ifdef BENCH_KEY_OVERRIDE
     uint16_t start = timer_read();
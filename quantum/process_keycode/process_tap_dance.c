@@ -164,7 +164,12 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
             action->state.pressed = record->event.pressed;
             if (record->event.pressed) {
+#ifdef KEY_EVENT_QUEUE_ENABLE
+                // Queued key events carry the time of the scan that found them
+                last_tap_time = record->event.time;
+#else
                 last_tap_time = timer_read();
+#endif
                 process_tap_dance_action_on_each_tap(action);
                 active_td = action->state.finished ? 0 : keycode;
             } else {
@@ -194,6 +199,22 @@ void tap_dance_task(void) {
     }
 }
 
+uint32_t tap_dance_next_deadline(void) {
+    if (!active_td) {
+        return UINT32_MAX;
+    }
+
+    tap_dance_action_t *action = tap_dance_get(QK_TAP_DANCE_GET_INDEX(active_td));
+    if (action->state.interrupted || action->state.finished) {
+        return UINT32_MAX;
+    }
+
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    // tap_dance_task() fires once the elapsed time exceeds the tapping term
+    return elapsed > term ? 0 : term - elapsed + 1;
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
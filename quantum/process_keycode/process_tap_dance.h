@@ -82,9 +82,10 @@ void reset_tap_dance(tap_dance_state_t *state);
 
 /* To be used internally */
 
-bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record);
-bool process_tap_dance(uint16_t keycode, keyrecord_t *record);
-void tap_dance_task(void);
+bool     preprocess_tap_dance(uint16_t keycode, keyrecord_t *record);
+bool     process_tap_dance(uint16_t keycode, keyrecord_t *record);
+void     tap_dance_task(void);
+uint32_t tap_dance_next_deadline(void);
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data);
 void tap_dance_pair_finished(tap_dance_state_t *state, void *user_data);
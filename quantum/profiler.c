@@ -0,0 +1,394 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include <string.h>
+#include "profiler.h"
+#include "scan_stage.h"
+#include "timer.h"
+#include "print.h"
+
+#if defined(RAW_ENABLE) && defined(PROFILER_RAW_HID_DRAIN)
+#    include "raw_hid.h"
+#    ifndef PROFILER_RAW_HID_ID
+#        define PROFILER_RAW_HID_ID 0xFE
+#    endif
+#    ifndef RAW_EPSIZE
+#        define RAW_EPSIZE 32
+#    endif
+#endif
+
+//------------------------------------
+// Platform timestamp sources. Platforms not listed here (e.g. the host test platform) provide profiler_read_cycles()
+// themselves.
+//
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+uint32_t profiler_read_cycles(void) {
+    return chSysGetRealtimeCounterX();
+}
+#elif defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#    if defined(__AVR_ATmega32A__)
+#        define PROFILER_TIMER_MATCH_PENDING() (TIFR & _BV(OCF0))
+#    elif defined(__AVR_ATtiny85__)
+#        define PROFILER_TIMER_MATCH_PENDING() (TIFR & _BV(OCF0A))
+#    else
+#        define PROFILER_TIMER_MATCH_PENDING() (TIFR0 & _BV(OCF0A))
+#    endif
+uint32_t profiler_read_cycles(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    bool     match_pending;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms            = timer_read32();
+        raw           = TIMER_RAW;
+        match_pending = PROFILER_TIMER_MATCH_PENDING();
+    }
+    // Millisecond count extended with the raw timer count, in units of TIMER_RAW_FREQ
+    return profiler_timer_cycles(ms, raw, TIMER_RAW_TOP, match_pending);
+}
+#endif
+
+uint32_t profiler_timer_cycles(uint32_t ms, uint16_t raw, uint16_t top, bool match_pending) {
+    // A match made before the timer was read has wrapped it back to 0 without the interrupt counting the millisecond
+    // yet. A timer read at top can only have been read just before a match made since.
+    if (match_pending && raw < top) {
+        ms++;
+    }
+    // In CTC mode the timer counts from 0 to top, so a millisecond is top + 1 ticks
+    return ms * (top + 1) + raw;
+}
+
+//------------------------------------
+// State
+//
+
+#define PROFILER_RING_MASK (PROFILER_RING_SIZE - 1)
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint8_t  parent;
+    uint16_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+} zone_stats_t;
+
+typedef struct {
+    uint8_t  zone;
+    uint32_t start;
+} stack_entry_t;
+
+static profiler_zone_t *zones[PROFILER_MAX_ZONES];
+static zone_stats_t     stats[PROFILER_MAX_ZONES];
+static uint8_t          zone_count = 0;
+
+static stack_entry_t stack[PROFILER_MAX_DEPTH];
+static uint8_t       stack_depth    = 0;
+static uint8_t       overflow_depth = 0;
+
+// Single-producer single-consumer ring: zone exits write at head, profiler_drain() reads at tail.
+static profiler_sample_t ring[PROFILER_RING_SIZE];
+static uint8_t           ring_head       = 0;
+static uint8_t           ring_tail       = 0;
+static uint32_t          dropped_samples = 0;
+
+//------------------------------------
+// Sample collection
+//
+
+static uint8_t register_zone(profiler_zone_t *zone) {
+    if (zone_count >= PROFILER_MAX_ZONES) {
+        return PROFILER_INVALID_ZONE;
+    }
+    zone->id          = zone_count;
+    zones[zone_count] = zone;
+    memset(&stats[zone_count], 0, sizeof(zone_stats_t));
+    stats[zone_count].min    = UINT32_MAX;
+    stats[zone_count].parent = PROFILER_INVALID_ZONE;
+    return zone_count++;
+}
+
+static void ring_push(uint8_t zone, uint8_t parent, uint32_t cycles) {
+    uint8_t head = ring_head;
+    uint8_t next = (head + 1) & PROFILER_RING_MASK;
+    if (next == __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE)) {
+        dropped_samples++;
+        return;
+    }
+    ring[head] = (profiler_sample_t){.zone = zone, .parent = parent, .cycles = cycles};
+    __atomic_store_n(&ring_head, next, __ATOMIC_RELEASE);
+}
+
+void profiler_zone_enter(profiler_zone_t *zone) {
+    if (stack_depth >= PROFILER_MAX_DEPTH) {
+        overflow_depth++;
+        return;
+    }
+
+    if (zone->id == PROFILER_INVALID_ZONE) {
+        // Still pushed if registration fails, so that the matching exit stays balanced
+        register_zone(zone);
+    }
+
+    stack[stack_depth].zone = zone->id;
+    // Read the counter last, so the bookkeeping above is not attributed to the zone
+    stack[stack_depth++].start = profiler_read_cycles();
+}
+
+void profiler_zone_exit(profiler_zone_t *zone) {
+    uint32_t now = profiler_read_cycles();
+
+    if (overflow_depth > 0) {
+        overflow_depth--;
+        return;
+    }
+    if (stack_depth == 0) {
+        return;
+    }
+
+    stack_entry_t *entry = &stack[--stack_depth];
+    if (entry->zone == PROFILER_INVALID_ZONE || entry->zone != zone->id) {
+        return;
+    }
+
+    uint8_t parent = stack_depth > 0 ? stack[stack_depth - 1].zone : PROFILER_INVALID_ZONE;
+    ring_push(entry->zone, parent, now - entry->start);
+}
+
+//------------------------------------
+// Statistics
+//
+
+static uint8_t histogram_bucket(uint32_t cycles) {
+    uint8_t bucket = 0;
+    while (cycles) {
+        cycles >>= 1;
+        bucket++;
+    }
+    return bucket < PROFILER_HISTOGRAM_BUCKETS ? bucket : PROFILER_HISTOGRAM_BUCKETS - 1;
+}
+
+static uint32_t histogram_upper_bound(uint8_t bucket) {
+    return bucket >= 32 ? UINT32_MAX : (uint32_t)((1ULL << bucket) - 1);
+}
+
+static void accumulate(const profiler_sample_t *sample) {
+    if (sample->zone >= zone_count) {
+        return;
+    }
+
+    zone_stats_t *s = &stats[sample->zone];
+    s->count++;
+    s->total += sample->cycles;
+    if (sample->parent != sample->zone) {
+        // Recursive entry of the same zone should not detach it from its real parent
+        s->parent = sample->parent;
+    }
+    if (sample->cycles < s->min) s->min = sample->cycles;
+    if (sample->cycles > s->max) s->max = sample->cycles;
+
+    uint8_t bucket = histogram_bucket(sample->cycles);
+    if (s->histogram[bucket] == UINT16_MAX) {
+        // Halve the whole histogram rather than saturating, to keep its shape
+        for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+            s->histogram[i] >>= 1;
+        }
+    }
+    s->histogram[bucket]++;
+}
+
+static uint32_t histogram_p99(const zone_stats_t *s) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        total += s->histogram[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint32_t rank       = (total * 99 + 99) / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        cumulative += s->histogram[i];
+        if (cumulative >= rank) {
+            uint32_t bound = histogram_upper_bound(i);
+            return bound < s->max ? bound : s->max;
+        }
+    }
+    return s->max;
+}
+
+void profiler_drain(void) {
+    uint8_t tail = ring_tail;
+    while (tail != __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE)) {
+        profiler_sample_t sample = ring[tail];
+        tail                     = (tail + 1) & PROFILER_RING_MASK;
+        __atomic_store_n(&ring_tail, tail, __ATOMIC_RELEASE);
+        accumulate(&sample);
+    }
+}
+
+void profiler_reset(void) {
+    profiler_drain();
+    for (uint8_t i = 0; i < zone_count; i++) {
+        uint8_t parent = stats[i].parent;
+        memset(&stats[i], 0, sizeof(zone_stats_t));
+        stats[i].min    = UINT32_MAX;
+        stats[i].parent = parent;
+    }
+    dropped_samples = 0;
+}
+
+uint8_t profiler_zone_count(void) {
+    return zone_count;
+}
+
+uint32_t profiler_dropped_samples(void) {
+    return dropped_samples;
+}
+
+bool profiler_get_zone_stats(uint8_t id, profiler_zone_stats_t *out) {
+    if (id >= zone_count || !out) {
+        return false;
+    }
+
+    const zone_stats_t *s = &stats[id];
+    out->name             = zones[id]->name;
+    out->parent           = s->parent;
+    out->count            = s->count;
+    out->min              = s->count ? s->min : 0;
+    out->max              = s->max;
+    out->mean             = s->count ? (uint32_t)(s->total / s->count) : 0;
+    out->p99              = histogram_p99(s);
+    return true;
+}
+
+//------------------------------------
+// Reporting
+//
+
+static void print_zone_tree(uint8_t parent, uint8_t depth) {
+    for (uint8_t id = 0; id < zone_count; id++) {
+        if (stats[id].parent != parent || id == parent) {
+            continue;
+        }
+
+        profiler_zone_stats_t s;
+        profiler_get_zone_stats(id, &s);
+        for (uint8_t i = 0; i < depth; i++) {
+            xprintf("  ");
+        }
+        xprintf("%s: n=%lu min=%lu mean=%lu p99=%lu max=%lu\n", s.name, (unsigned long)s.count, (unsigned long)s.min, (unsigned long)s.mean, (unsigned long)s.p99, (unsigned long)s.max);
+
+        if (depth + 1 < PROFILER_MAX_DEPTH) {
+            print_zone_tree(id, depth + 1);
+        }
+    }
+}
+
+void profiler_print_report(void) {
+    xprintf("profiler: %u zones, %lu dropped\n", (unsigned)zone_count, (unsigned long)dropped_samples);
+    print_zone_tree(PROFILER_INVALID_ZONE, 1);
+}
+
+#if defined(RAW_ENABLE) && defined(PROFILER_RAW_HID_DRAIN)
+
+enum profiler_raw_hid_packet_type {
+    PROFILER_PACKET_ZONE_NAME = 0x00,
+    PROFILER_PACKET_SAMPLES   = 0x01,
+};
+
+#    define PROFILER_SAMPLE_PACKED_SIZE 6
+#    define PROFILER_SAMPLES_PER_PACKET ((RAW_EPSIZE - 3) / PROFILER_SAMPLE_PACKED_SIZE)
+
+static uint8_t names_sent = 0;
+
+static void raw_hid_drain(void) {
+    uint8_t packet[RAW_EPSIZE];
+
+    // Announce any zones registered since the last drain, so the host can name the samples
+    while (names_sent < zone_count) {
+        memset(packet, 0, sizeof(packet));
+        packet[0] = PROFILER_RAW_HID_ID;
+        packet[1] = PROFILER_PACKET_ZONE_NAME;
+        packet[2] = names_sent;
+        strncpy((char *)&packet[3], zones[names_sent]->name, RAW_EPSIZE - 4);
+        raw_hid_send(packet, RAW_EPSIZE);
+        names_sent++;
+    }
+
+    uint8_t tail = ring_tail;
+    while (tail != __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE)) {
+        memset(packet, 0, sizeof(packet));
+        packet[0] = PROFILER_RAW_HID_ID;
+        packet[1] = PROFILER_PACKET_SAMPLES;
+
+        uint8_t  count = 0;
+        uint8_t *out   = &packet[3];
+        while (count < PROFILER_SAMPLES_PER_PACKET && tail != __atomic_load_n(&ring_head, __ATOMIC_ACQUIRE)) {
+            profiler_sample_t sample = ring[tail];
+            tail                     = (tail + 1) & PROFILER_RING_MASK;
+            __atomic_store_n(&ring_tail, tail, __ATOMIC_RELEASE);
+            accumulate(&sample);
+
+            out[0] = sample.zone;
+            out[1] = sample.parent;
+            out[2] = sample.cycles & 0xFF;
+            out[3] = (sample.cycles >> 8) & 0xFF;
+            out[4] = (sample.cycles >> 16) & 0xFF;
+            out[5] = (sample.cycles >> 24) & 0xFF;
+            out += PROFILER_SAMPLE_PACKED_SIZE;
+            count++;
+        }
+
+        packet[2] = count;
+        raw_hid_send(packet, RAW_EPSIZE);
+    }
+}
+
+#endif // defined(RAW_ENABLE) && defined(PROFILER_RAW_HID_DRAIN)
+
+void profiler_task(void) {
+#if defined(RAW_ENABLE) && defined(PROFILER_RAW_HID_DRAIN)
+    raw_hid_drain();
+#else
+    profiler_drain();
+#endif
+
+#if PROFILER_REPORT_INTERVAL > 0
+    static uint32_t last_report = 0;
+    if (timer_elapsed32(last_report) >= PROFILER_REPORT_INTERVAL) {
+        last_report = timer_read32();
+#    ifdef CONSOLE_ENABLE
+        profiler_print_report();
+#    endif
+        profiler_reset();
+    }
+#endif
+}
+
+//------------------------------------
+// Scan loop stages are profiled automatically, unless something else has claimed the hooks.
+//
+
+#ifndef SCAN_STAGE_HOOKS_ENABLE
+static profiler_zone_t stage_zones[SCAN_STAGE_COUNT] = {
+    [SCAN_STAGE_MATRIX_TASK]        = {.name = "matrix_task", .id = PROFILER_INVALID_ZONE},
+    [SCAN_STAGE_ACTION_EXEC]        = {.name = "action_exec", .id = PROFILER_INVALID_ZONE},
+    [SCAN_STAGE_QUANTUM_TASK]       = {.name = "quantum_task", .id = PROFILER_INVALID_ZONE},
+    [SCAN_STAGE_HOST_KEYBOARD_SEND] = {.name = "host_keyboard_send", .id = PROFILER_INVALID_ZONE},
+};
+
+void scan_stage_enter(scan_stage_t stage) {
+    profiler_zone_enter(&stage_zones[stage]);
+}
+
+void scan_stage_exit(scan_stage_t stage) {
+    profiler_zone_exit(&stage_zones[stage]);
+}
+#endif
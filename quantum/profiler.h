@@ -0,0 +1,181 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Hierarchical zone profiler.
+
+    Named zones are entered and exited around the code of interest, and may be nested. Each exit pushes a raw sample
+    into a fixed-size lock-free ring, which is drained by profiler_task() into per-zone statistics (count, min, max,
+    mean and a log2 histogram used for p99 estimation). Statistics are periodically printed over console, or raw
+    samples are streamed over raw HID if PROFILER_RAW_HID_DRAIN is defined.
+
+    Usage example:
+
+        #include "profiler.h"
+
+        void matrix_scan_user(void) {
+            PROFILE_ZONE_BEGIN(scan_user);
+            do_something();
+            PROFILE_ZONE(inner_work, do_something_else());
+            PROFILE_ZONE_END(scan_user);
+        }
+
+    Everything in this header compiles to nothing unless PROFILER_ENABLE is defined.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef PROFILER_MAX_ZONES
+#    define PROFILER_MAX_ZONES 16
+#endif
+
+#ifndef PROFILER_MAX_DEPTH
+#    define PROFILER_MAX_DEPTH 8
+#endif
+
+#ifndef PROFILER_RING_SIZE
+#    define PROFILER_RING_SIZE 64
+#endif
+
+#if (PROFILER_RING_SIZE & (PROFILER_RING_SIZE - 1)) != 0 || PROFILER_RING_SIZE > 128
+#    error PROFILER_RING_SIZE must be a power of two, no larger than 128
+#endif
+
+#ifndef PROFILER_HISTOGRAM_BUCKETS
+#    define PROFILER_HISTOGRAM_BUCKETS 32
+#endif
+
+#ifndef PROFILER_REPORT_INTERVAL
+#    define PROFILER_REPORT_INTERVAL 5000
+#endif
+
+#define PROFILER_INVALID_ZONE 0xFF
+
+/**
+ * @brief Per-site zone descriptor. Allocated statically by the PROFILE_ZONE_* macros and registered on first use.
+ */
+typedef struct profiler_zone_t {
+    const char *name;
+    uint8_t     id;
+} profiler_zone_t;
+
+/**
+ * @brief Raw sample, as stored in the ring buffer.
+ */
+typedef struct profiler_sample_t {
+    uint8_t  zone;
+    uint8_t  parent;
+    uint32_t cycles;
+} profiler_sample_t;
+
+/**
+ * @brief Summary of the samples drained for a zone since the last reset.
+ */
+typedef struct profiler_zone_stats_t {
+    const char *name;
+    uint8_t     parent;
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint32_t    mean;
+    uint32_t    p99;
+} profiler_zone_stats_t;
+
+#ifdef PROFILER_ENABLE
+
+/**
+ * @brief Reads the free-running counter used to timestamp zones. Provided by the platform.
+ */
+uint32_t profiler_read_cycles(void);
+
+/**
+ * @brief Combines a millisecond count with the count of a timer running from 0 to top once every millisecond, both read
+ * with interrupts masked, into a timestamp in timer ticks. match_pending is whether the timer's compare match was still
+ * waiting to be handled when they were read.
+ */
+uint32_t profiler_timer_cycles(uint32_t ms, uint16_t raw, uint16_t top, bool match_pending);
+
+void profiler_zone_enter(profiler_zone_t *zone);
+void profiler_zone_exit(profiler_zone_t *zone);
+
+/**
+ * @brief Moves any pending samples from the ring into the per-zone statistics, and emits a report every
+ * PROFILER_REPORT_INTERVAL milliseconds. Invoked from the main loop.
+ */
+void profiler_task(void);
+
+/**
+ * @brief Moves any pending samples from the ring into the per-zone statistics.
+ */
+void profiler_drain(void);
+
+/**
+ * @brief Clears all accumulated statistics. Registered zones are retained.
+ */
+void profiler_reset(void);
+
+/**
+ * @brief Number of zones registered so far.
+ */
+uint8_t profiler_zone_count(void);
+
+/**
+ * @brief Retrieves the statistics for the zone with the given id.
+ *
+ * @return false if no zone with that id has been registered
+ */
+bool profiler_get_zone_stats(uint8_t id, profiler_zone_stats_t *stats);
+
+/**
+ * @brief Number of samples dropped because the ring was full when a zone exited.
+ */
+uint32_t profiler_dropped_samples(void);
+
+/**
+ * @brief Prints the statistics of all zones over console, as a tree.
+ */
+void profiler_print_report(void);
+
+#    define PROFILE_ZONE_BEGIN(zone)                                                                      \
+        static profiler_zone_t profiler_zone_##zone = {.name = #zone, .id = PROFILER_INVALID_ZONE}; \
+        profiler_zone_enter(&profiler_zone_##zone)
+#    define PROFILE_ZONE_END(zone) profiler_zone_exit(&profiler_zone_##zone)
+#    define PROFILE_ZONE_NAMED(zone_name, ...)                                                                  \
+        do {                                                                                                  \
+            static profiler_zone_t profiler_zone_named = {.name = (zone_name), .id = PROFILER_INVALID_ZONE}; \
+            profiler_zone_enter(&profiler_zone_named);                                                        \
+            do {                                                                                              \
+                __VA_ARGS__;                                                                                  \
+            } while (0);                                                                                      \
+            profiler_zone_exit(&profiler_zone_named);                                                         \
+        } while (0)
+
+#else
+
+#    define PROFILE_ZONE_BEGIN(zone) \
+        do {                         \
+        } while (0)
+#    define PROFILE_ZONE_END(zone) \
+        do {                       \
+        } while (0)
+#    define PROFILE_ZONE_NAMED(zone_name, ...) \
+        do {                                   \
+            __VA_ARGS__;                       \
+        } while (0)
+
+#endif // PROFILER_ENABLE
+
+/**
+ * @brief Profiles the supplied statement(s) as a zone named `zone`.
+ */
+#define PROFILE_ZONE(zone, ...) PROFILE_ZONE_NAMED(#zone, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
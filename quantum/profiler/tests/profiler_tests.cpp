@@ -0,0 +1,209 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "profiler.h"
+#include "scan_stage.h"
+
+void set_cycles(uint32_t cycles);
+void advance_cycles(uint32_t cycles);
+}
+
+class Profiler : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_cycles(0);
+        profiler_reset();
+    }
+
+    profiler_zone_stats_t stats_for(uint8_t id) {
+        profiler_zone_stats_t stats;
+        EXPECT_TRUE(profiler_get_zone_stats(id, &stats));
+        return stats;
+    }
+};
+
+TEST_F(Profiler, SingleZoneIsMeasured) {
+    PROFILE_ZONE_BEGIN(single);
+    advance_cycles(100);
+    PROFILE_ZONE_END(single);
+
+    profiler_drain();
+    auto stats = stats_for(profiler_zone_single.id);
+    EXPECT_STREQ(stats.name, "single");
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.min, 100);
+    EXPECT_EQ(stats.max, 100);
+    EXPECT_EQ(stats.mean, 100);
+    EXPECT_EQ(stats.parent, PROFILER_INVALID_ZONE);
+}
+
+TEST_F(Profiler, NestedZonesRecordParent) {
+    PROFILE_ZONE_BEGIN(outer);
+    advance_cycles(10);
+    PROFILE_ZONE_BEGIN(inner);
+    advance_cycles(20);
+    PROFILE_ZONE_END(inner);
+    advance_cycles(10);
+    PROFILE_ZONE_END(outer);
+
+    profiler_drain();
+    auto outer = stats_for(profiler_zone_outer.id);
+    auto inner = stats_for(profiler_zone_inner.id);
+    EXPECT_EQ(outer.mean, 40);
+    EXPECT_EQ(inner.mean, 20);
+    EXPECT_EQ(inner.parent, profiler_zone_outer.id);
+    EXPECT_EQ(outer.parent, PROFILER_INVALID_ZONE);
+}
+
+TEST_F(Profiler, ZoneMacroWrapsStatement) {
+    int  calls = 0;
+    auto work  = [&]() {
+        calls++;
+        advance_cycles(7);
+    };
+
+    for (int i = 0; i < 3; i++) {
+        PROFILE_ZONE(wrapped, work());
+    }
+    EXPECT_EQ(calls, 3);
+
+    profiler_drain();
+    bool found = false;
+    for (uint8_t id = 0; id < profiler_zone_count(); id++) {
+        auto stats = stats_for(id);
+        if (std::string(stats.name) == "wrapped") {
+            found = true;
+            EXPECT_EQ(stats.count, 3);
+            EXPECT_EQ(stats.mean, 7);
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST_F(Profiler, P99IgnoresRareOutlier) {
+    uint8_t id = PROFILER_INVALID_ZONE;
+    for (int i = 0; i < 200; i++) {
+        PROFILE_ZONE_BEGIN(mostly_fast);
+        advance_cycles(i == 100 ? 100000 : 10);
+        PROFILE_ZONE_END(mostly_fast);
+        id = profiler_zone_mostly_fast.id;
+        profiler_drain();
+    }
+
+    auto stats = stats_for(id);
+    EXPECT_EQ(stats.count, 200);
+    EXPECT_EQ(stats.min, 10);
+    EXPECT_EQ(stats.max, 100000);
+    // log2 histogram: 10 falls in the [8, 15] bucket
+    EXPECT_GE(stats.p99, 10);
+    EXPECT_LE(stats.p99, 15);
+}
+
+TEST_F(Profiler, P99TracksFrequentSlowPath) {
+    uint8_t id = PROFILER_INVALID_ZONE;
+    for (int i = 0; i < 100; i++) {
+        PROFILE_ZONE_BEGIN(often_slow);
+        advance_cycles(i % 10 == 0 ? 1000 : 10);
+        PROFILE_ZONE_END(often_slow);
+        id = profiler_zone_often_slow.id;
+        profiler_drain();
+    }
+
+    auto stats = stats_for(id);
+    EXPECT_EQ(stats.p99, 1000);
+}
+
+TEST_F(Profiler, FullRingDropsSamples) {
+    uint8_t id = PROFILER_INVALID_ZONE;
+    for (int i = 0; i < PROFILER_RING_SIZE + 4; i++) {
+        PROFILE_ZONE_BEGIN(flood);
+        advance_cycles(1);
+        PROFILE_ZONE_END(flood);
+        id = profiler_zone_flood.id;
+    }
+
+    // One slot is always kept free to distinguish a full ring from an empty one
+    EXPECT_EQ(profiler_dropped_samples(), 5);
+
+    profiler_drain();
+    auto stats = stats_for(id);
+    EXPECT_EQ(stats.count, PROFILER_RING_SIZE - 1);
+}
+
+TEST_F(Profiler, NestingBeyondMaxDepthStaysBalanced) {
+    PROFILE_ZONE_BEGIN(d1);
+    PROFILE_ZONE_BEGIN(d2);
+    PROFILE_ZONE_BEGIN(d3);
+    PROFILE_ZONE_BEGIN(d4);
+    PROFILE_ZONE_BEGIN(d5);
+    advance_cycles(5);
+    PROFILE_ZONE_END(d5);
+    PROFILE_ZONE_END(d4);
+    PROFILE_ZONE_END(d3);
+    PROFILE_ZONE_END(d2);
+    advance_cycles(5);
+    PROFILE_ZONE_END(d1);
+
+    profiler_drain();
+    EXPECT_EQ(stats_for(profiler_zone_d1.id).mean, 10);
+    EXPECT_EQ(stats_for(profiler_zone_d4.id).mean, 5);
+    EXPECT_EQ(stats_for(profiler_zone_d4.id).parent, profiler_zone_d3.id);
+    // d5 is beyond PROFILER_MAX_DEPTH, so was never registered
+    EXPECT_EQ(profiler_zone_d5.id, PROFILER_INVALID_ZONE);
+}
+
+TEST_F(Profiler, ResetClearsStatistics) {
+    PROFILE_ZONE_BEGIN(cleared);
+    advance_cycles(3);
+    PROFILE_ZONE_END(cleared);
+
+    profiler_reset();
+    auto stats = stats_for(profiler_zone_cleared.id);
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_EQ(stats.min, 0);
+    EXPECT_EQ(stats.max, 0);
+    EXPECT_EQ(stats.p99, 0);
+}
+
+TEST_F(Profiler, ScanStagesAreProfiled) {
+    SCAN_STAGE_ENTER(SCAN_STAGE_MATRIX_TASK);
+    advance_cycles(50);
+    SCAN_STAGE_ENTER(SCAN_STAGE_ACTION_EXEC);
+    advance_cycles(25);
+    SCAN_STAGE_EXIT(SCAN_STAGE_ACTION_EXEC);
+    SCAN_STAGE_EXIT(SCAN_STAGE_MATRIX_TASK);
+
+    profiler_drain();
+    uint8_t matrix_id = PROFILER_INVALID_ZONE;
+    uint8_t action_id = PROFILER_INVALID_ZONE;
+    for (uint8_t id = 0; id < profiler_zone_count(); id++) {
+        auto name = std::string(stats_for(id).name);
+        if (name == "matrix_task") matrix_id = id;
+        if (name == "action_exec") action_id = id;
+    }
+    ASSERT_NE(matrix_id, PROFILER_INVALID_ZONE);
+    ASSERT_NE(action_id, PROFILER_INVALID_ZONE);
+    EXPECT_EQ(stats_for(matrix_id).mean, 75);
+    EXPECT_EQ(stats_for(action_id).mean, 25);
+    EXPECT_EQ(stats_for(action_id).parent, matrix_id);
+}
+
+TEST_F(Profiler, TimerCyclesCountAWrapNotYetHandled) {
+    // A millisecond is 250 ticks of a timer counting from 0 to 249
+    EXPECT_EQ(profiler_timer_cycles(5, 0, 249, false), 1250);
+    EXPECT_EQ(profiler_timer_cycles(5, 249, 249, false), 1499);
+
+    // The timer wraps between reading the millisecond count and the timer, before the interrupt has counted it
+    EXPECT_EQ(profiler_timer_cycles(5, 1, 249, true), 1501);
+    // The match is made after the timer is read, so it is not counted
+    EXPECT_EQ(profiler_timer_cycles(5, 249, 249, true), 1499);
+
+    // Timestamps carry on a tick at a time across the wrap
+    for (uint16_t tick = 240; tick < 260; tick++) {
+        uint32_t now = tick < 250 ? profiler_timer_cycles(5, tick, 249, false) : profiler_timer_cycles(5, tick - 250, 249, true);
+        EXPECT_EQ(now, 1250 + tick);
+    }
+}
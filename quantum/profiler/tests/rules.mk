@@ -0,0 +1,7 @@
+profiler_DEFS := -DPROFILER_ENABLE -DNO_PRINT
+profiler_DEFS += -DPROFILER_RING_SIZE=16 -DPROFILER_MAX_DEPTH=4
+
+profiler_SRC := \
+    $(QUANTUM_PATH)/profiler/tests/profiler_tests.cpp \
+    $(QUANTUM_PATH)/profiler.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -52,6 +52,7 @@
 #include "action_tapping.h"
 #include "print.h"
 #include "debug.h"
+#include "profiler.h"
 #include "suspend.h"
 #include <stddef.h>
 #include <stdlib.h>
@@ -240,6 +241,10 @@ extern layer_state_t layer_state;
 #    include "os_detection.h"
 #endif
 
+#ifdef KEYSTROKE_TRACE_ENABLE
+#    include "keystroke_trace.h"
+#endif
+
 void set_single_persistent_default_layer(uint8_t default_layer);
 
 #define IS_LAYER_ON(layer) layer_state_is(layer)
@@ -256,6 +261,7 @@ bool     pre_process_record_user(uint16_t keycode, keyrecord_t *record);
 bool     process_action_kb(keyrecord_t *record);
 bool     process_record_kb(uint16_t keycode, keyrecord_t *record);
 bool     process_record_user(uint16_t keycode, keyrecord_t *record);
+bool     process_record_handlers(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_kb(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_user(uint16_t keycode, keyrecord_t *record);
 
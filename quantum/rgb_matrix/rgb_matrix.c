@@ -29,12 +29,114 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+#    include "rgb_matrix_pacing.h"
+#    include "timer.h"
+#    ifdef KEY_EVENT_QUEUE_ENABLE
+#        include "key_event_queue.h"
+#    endif
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
+// Only set once checked against the center and points in use, which config.h or keyboard code may have changed
+#ifdef RGB_MATRIX_LED_POLAR_TABLE
+static const led_polar_t *rgb_matrix_polar = NULL;
+#endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+static const uint8_t *rgb_matrix_distances = NULL;
+#endif
+
+#if defined(RGB_MATRIX_LED_POLAR_TABLE) || defined(RGB_MATRIX_LED_DISTANCE_TABLE)
+__attribute__((weak)) const led_point_t *rgb_matrix_table_points(void) {
+    return NULL;
+}
+#endif
+
+#ifdef RGB_MATRIX_LED_POLAR_TABLE
+__attribute__((weak)) const led_polar_config_t *rgb_matrix_polar_config(void) {
+    return NULL;
+}
+#endif
+
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+__attribute__((weak)) const uint8_t *rgb_matrix_distance_table(void) {
+    return NULL;
+}
+#endif
+
+static void rgb_matrix_init_tables(void) {
+#if defined(RGB_MATRIX_LED_POLAR_TABLE) || defined(RGB_MATRIX_LED_DISTANCE_TABLE)
+    const led_point_t *points = rgb_matrix_table_points();
+
+#    ifdef RGB_MATRIX_LED_POLAR_TABLE
+    rgb_matrix_polar = NULL;
+#    endif
+#    ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    rgb_matrix_distances = NULL;
+#    endif
+    if (points == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (pgm_read_byte(&points[i].x) != g_led_config.point[i].x || pgm_read_byte(&points[i].y) != g_led_config.point[i].y) {
+            return;
+        }
+    }
+
+    // Each table only depends on the points, and the polar table on the center too
+#    ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    rgb_matrix_distances = rgb_matrix_distance_table();
+#    endif
+#    ifdef RGB_MATRIX_LED_POLAR_TABLE
+    const led_polar_config_t *config = rgb_matrix_polar_config();
+    if (config != NULL && pgm_read_byte(&config->center.x) == k_rgb_matrix_center.x && pgm_read_byte(&config->center.y) == k_rgb_matrix_center.y) {
+        rgb_matrix_polar = config->polar;
+    }
+#    endif
+#endif
+}
+
+led_polar_t rgb_matrix_led_polar(uint8_t index) {
+#ifdef RGB_MATRIX_LED_POLAR_TABLE
+    if (rgb_matrix_polar) {
+        return (led_polar_t){pgm_read_byte(&rgb_matrix_polar[index].angle), pgm_read_byte(&rgb_matrix_polar[index].dist)};
+    }
+#endif
+    int16_t dx = g_led_config.point[index].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_rgb_matrix_center.y;
+    return (led_polar_t){atan2_8(dy, dx), sqrt16(dx * dx + dy * dy)};
+}
+
+uint8_t rgb_matrix_led_distance_from_center(uint8_t index) {
+#ifdef RGB_MATRIX_LED_POLAR_TABLE
+    if (rgb_matrix_polar) {
+        return pgm_read_byte(&rgb_matrix_polar[index].dist);
+    }
+#endif
+    int16_t dx = g_led_config.point[index].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_rgb_matrix_center.y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
+uint8_t rgb_matrix_led_distance(uint8_t led_a, uint8_t led_b) {
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+    if (rgb_matrix_distances) {
+        if (led_a == led_b) {
+            return 0;
+        }
+        return pgm_read_byte(&rgb_matrix_distances[led_distance_index(led_a, led_b)]);
+    }
+#endif
+    int16_t dx = g_led_config.point[led_a].x - g_led_config.point[led_b].x;
+    int16_t dy = g_led_config.point[led_a].y - g_led_config.point[led_b].y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
 __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
@@ -77,6 +179,19 @@ static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
 
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+// LEDs rendered in each pass of this frame, and what was measured of it for the governor
+static uint8_t                   rgb_process_limit;
+static rgb_matrix_pacing_frame_t rgb_pacing_frame;
+#    define RGB_MATRIX_PROCESS_CHUNK rgb_process_limit
+#    define RGB_MATRIX_FLUSH_INTERVAL rgb_matrix_pacing_interval()
+#else
+#    if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#        define RGB_MATRIX_PROCESS_CHUNK RGB_MATRIX_LED_PROCESS_LIMIT
+#    endif
+#    define RGB_MATRIX_FLUSH_INTERVAL RGB_MATRIX_LED_FLUSH_LIMIT
+#endif
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -261,13 +376,21 @@ static void rgb_task_timers(void) {
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_FLUSH_INTERVAL) rgb_task_state = STARTING;
 }
 
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+    // pace the frames to come by the last one, and keep the same chunks for all of this one
+    rgb_pacing_frame.frame_time = rgb_timer_buffer - g_rgb_timer;
+    rgb_matrix_pacing_update(&rgb_pacing_frame);
+    rgb_pacing_frame  = (rgb_matrix_pacing_frame_t){0};
+    rgb_process_limit = rgb_matrix_pacing_chunk();
+#endif
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -344,13 +467,43 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    // only queue the writes, rgb_matrix_task() sends them while the keyboard keeps scanning
+    led_flush_queue_defer(true);
+    rgb_matrix_update_pwm_buffers();
+    led_flush_queue_defer(false);
+#else
     rgb_matrix_update_pwm_buffers();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
 }
 
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+static bool rgb_task_input_pending(void) {
+#    ifdef KEY_EVENT_QUEUE_ENABLE
+    if (key_event_queue_depth() > 0) return true;
+#    endif
+    // a key changed in this pass of the scan loop
+    return last_matrix_activity_elapsed() == 0;
+}
+#endif
+
 void rgb_matrix_task(void) {
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+    uint32_t task_start = timer_read32();
+    rgb_pacing_frame.scans++;
+#endif
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    // send the next write of the last frame flushed
+    led_flush_queue_task();
+#    ifdef RGB_MATRIX_ADAPTIVE_PACING
+    rgb_pacing_frame.flush_time += timer_elapsed32(task_start);
+    task_start = timer_read32();
+#    endif
+#endif
+
     rgb_task_timers();
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
@@ -363,6 +516,12 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+    // leave the pass to the keys, a frame that was due is dropped rather than caught up with
+    if (rgb_task_state != SYNCING && rgb_task_input_pending()) return;
+    rgb_task_states state = rgb_task_state;
+#endif
+
     switch (rgb_task_state) {
         case STARTING:
             rgb_task_start();
@@ -377,12 +536,24 @@ void rgb_matrix_task(void) {
             }
             break;
         case FLUSHING:
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+            // the last frame has to be sent first, so that the queue only ever holds one
+            if (led_flush_queue_busy()) break;
+#endif
             rgb_task_flush(effect);
             break;
         case SYNCING:
             rgb_task_sync();
             break;
     }
+
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+    if (state == RENDERING) {
+        rgb_pacing_frame.render_time += timer_elapsed32(task_start);
+    } else if (state == FLUSHING) {
+        rgb_pacing_frame.flush_time += timer_elapsed32(task_start);
+    }
+#endif
 }
 
 void rgb_matrix_indicators(void) {
@@ -399,17 +570,17 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_PROCESS_CHUNK)
 #    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_PROCESS_CHUNK * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_PROCESS_CHUNK;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
     uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
 #    else
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_PROCESS_CHUNK * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_PROCESS_CHUNK;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
 #    endif
 #else
@@ -447,6 +618,12 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    rgb_matrix_init_tables();
+
+#ifdef RGB_MATRIX_ADAPTIVE_PACING
+    rgb_matrix_pacing_init(RGB_MATRIX_LED_COUNT, RGB_MATRIX_LED_PROCESS_LIMIT, RGB_MATRIX_LED_FLUSH_LIMIT);
+    rgb_process_limit = rgb_matrix_pacing_chunk();
+#endif
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -473,6 +650,9 @@ void rgb_matrix_set_suspend_state(bool state) {
     if (state && !suspend_state) { // only run if turning off, and only once
         rgb_task_render(0);        // turn off all LEDs when suspending
         rgb_task_flush(0);         // and actually flash led state to LEDs
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+        led_flush_queue_wait();
+#endif
     }
     suspend_state = state;
 #endif
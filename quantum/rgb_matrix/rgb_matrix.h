@@ -211,6 +211,23 @@ led_flags_t rgb_matrix_get_flags(void);
 void        rgb_matrix_set_flags(led_flags_t flags);
 void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 
+/* Angle and distance of an LED from the center, from the generated table when RGB_MATRIX_LED_POLAR_TABLE is defined and it matches the LED layout */
+led_polar_t rgb_matrix_led_polar(uint8_t index);
+/* Distance of an LED from the center, from the same table as rgb_matrix_led_polar() but without working out the angle when it is not in use */
+uint8_t rgb_matrix_led_distance_from_center(uint8_t index);
+/* Distance between two LEDs, from the generated table when RGB_MATRIX_LED_DISTANCE_TABLE is defined and it matches the LED layout */
+uint8_t rgb_matrix_led_distance(uint8_t led_a, uint8_t led_b);
+/* The tables generated from info.json, see lib/python/qmk/cli/generate/keyboard_c.py, and the points they were computed from */
+#if defined(RGB_MATRIX_LED_POLAR_TABLE) || defined(RGB_MATRIX_LED_DISTANCE_TABLE)
+const led_point_t *rgb_matrix_table_points(void);
+#endif
+#ifdef RGB_MATRIX_LED_POLAR_TABLE
+const led_polar_config_t *rgb_matrix_polar_config(void);
+#endif
+#ifdef RGB_MATRIX_LED_DISTANCE_TABLE
+const uint8_t *rgb_matrix_distance_table(void);
+#endif
+
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_update_rgb_matrix
 #    define rgblight_reload_from_eeprom rgb_matrix_reload_from_eeprom
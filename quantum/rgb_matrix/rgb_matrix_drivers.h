@@ -37,6 +37,13 @@
 #    include "ws2812.h"
 #endif
 
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+#    if !(defined(RGB_MATRIX_IS31FL3729) || defined(RGB_MATRIX_IS31FL3731) || defined(RGB_MATRIX_IS31FL3733) || defined(RGB_MATRIX_IS31FL3736) || defined(RGB_MATRIX_IS31FL3737) || defined(RGB_MATRIX_IS31FL3741) || defined(RGB_MATRIX_IS31FL3742A) || defined(RGB_MATRIX_IS31FL3743A) || defined(RGB_MATRIX_IS31FL3745) || defined(RGB_MATRIX_IS31FL3746A) || defined(RGB_MATRIX_SNLED27351))
+#        error "RGB_MATRIX_ASYNC_FLUSH is only supported by the IS31FL37xx and SNLED27351 drivers"
+#    endif
+#    include "led_flush_queue.h"
+#endif
+
 typedef struct {
     /* Perform any initialisation required for the other driver functions to work. */
     void (*init)(void);
@@ -0,0 +1,121 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix_pacing.h"
+#include <stdbool.h>
+#include "debug.h"
+
+#ifndef RGB_MATRIX_PACING_SMOOTHING
+// Each frame moves the measured costs 1/2^n of the way towards its own
+#    define RGB_MATRIX_PACING_SMOOTHING 2
+#endif
+
+// Time each pass of the scan loop may take, in microseconds
+#define PACING_SCAN_BUDGET (1000000UL / RGB_MATRIX_PACING_SCAN_RATE)
+
+// Frames costing more than the longest interval are paced at it, so costs are capped there to keep to 32-bit maths
+#define PACING_MAX_COST (RGB_MATRIX_PACING_MAX_INTERVAL * 1000UL)
+
+#if PACING_MAX_COST * PACING_SCAN_BUDGET > 0xFFFFFFFF
+#    error "RGB_MATRIX_PACING_MAX_INTERVAL is too long for RGB_MATRIX_PACING_SCAN_RATE"
+#endif
+
+static uint8_t  led_count;
+static uint16_t min_interval;
+static uint8_t  chunk;
+static uint16_t interval;
+
+// Running averages of the measured costs, in microseconds
+static bool     measured;
+static uint32_t render_cost;
+static uint32_t flush_cost;
+static uint32_t scan_cost;
+
+static uint16_t frames;
+static uint32_t frames_time;
+static uint16_t fps;
+
+static uint32_t average(uint32_t current, uint32_t sample) {
+    if (!measured) {
+        return sample;
+    }
+    return current + ((int32_t)(sample - current) >> RGB_MATRIX_PACING_SMOOTHING);
+}
+
+void rgb_matrix_pacing_init(uint8_t count, uint8_t initial_chunk, uint16_t initial_interval) {
+    led_count    = count;
+    min_interval = initial_interval;
+    chunk        = initial_chunk > 0 && initial_chunk < count ? initial_chunk : count;
+    interval     = initial_interval;
+    measured     = false;
+    render_cost  = 0;
+    flush_cost   = 0;
+    scan_cost    = 0;
+    frames       = 0;
+    frames_time  = 0;
+    fps          = 0;
+}
+
+static void pace(void) {
+    if (scan_cost >= PACING_SCAN_BUDGET) {
+        // The loop is already too slow on its own, so do as little as possible in each pass
+        chunk    = 1;
+        interval = RGB_MATRIX_PACING_MAX_INTERVAL;
+        return;
+    }
+
+    // Render no more LEDs in a pass than fit in the time it has left
+    uint32_t slack = PACING_SCAN_BUDGET - scan_cost;
+    uint32_t leds  = render_cost > 0 ? slack * led_count / render_cost : led_count;
+    chunk          = leds < 1 ? 1 : leds > led_count ? led_count : leds;
+
+    // Leave enough passes between two frames for the scan rate to average out to the target over the frame
+    uint32_t cost           = render_cost + flush_cost;
+    uint32_t frame_interval = cost < PACING_MAX_COST ? (cost * PACING_SCAN_BUDGET / slack + 999) / 1000 : RGB_MATRIX_PACING_MAX_INTERVAL;
+    if (frame_interval > RGB_MATRIX_PACING_MAX_INTERVAL) {
+        frame_interval = RGB_MATRIX_PACING_MAX_INTERVAL;
+    }
+    if (frame_interval < min_interval) {
+        frame_interval = min_interval;
+    }
+    interval = frame_interval;
+}
+
+void rgb_matrix_pacing_update(const rgb_matrix_pacing_frame_t *frame) {
+    if (frame->scans == 0) {
+        return;
+    }
+
+    uint32_t rgb_time   = frame->render_time + frame->flush_time;
+    uint32_t other_time = frame->frame_time > rgb_time ? frame->frame_time - rgb_time : 0;
+    render_cost         = average(render_cost, frame->render_time * 1000);
+    flush_cost          = average(flush_cost, frame->flush_time * 1000);
+    scan_cost           = average(scan_cost, other_time * 1000 / frame->scans);
+    measured            = true;
+    pace();
+
+    frames++;
+    frames_time += frame->frame_time;
+    if (frames_time >= RGB_MATRIX_PACING_REPORT_INTERVAL) {
+        fps = (frames * 1000UL + frames_time / 2) / frames_time;
+        dprintf("rgb matrix: %u fps, %lu us per frame, %u LEDs per pass, %u ms between frames\n", fps, (unsigned long)rgb_matrix_pacing_frame_time(), chunk, interval);
+        frames      = 0;
+        frames_time = 0;
+    }
+}
+
+uint8_t rgb_matrix_pacing_chunk(void) {
+    return chunk;
+}
+
+uint16_t rgb_matrix_pacing_interval(void) {
+    return interval;
+}
+
+uint16_t rgb_matrix_pacing_fps(void) {
+    return fps;
+}
+
+uint32_t rgb_matrix_pacing_frame_time(void) {
+    return render_cost + flush_cost;
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/* Adaptive frame pacing for the RGB matrix.
+ *
+ * With RGB_MATRIX_ADAPTIVE_PACING = yes, rgb_matrix_task() measures how long each frame takes to render and flush,
+ * and how long the rest of the scan loop takes. From those, the governor picks how many LEDs are rendered in each pass
+ * of the scan loop, and how often a frame is started, so that the keyboard keeps scanning at least
+ * RGB_MATRIX_PACING_SCAN_RATE times a second. Frames are never started more often than RGB_MATRIX_LED_FLUSH_LIMIT
+ * allows, nor less often than RGB_MATRIX_PACING_MAX_INTERVAL.
+ */
+
+#ifndef RGB_MATRIX_PACING_SCAN_RATE
+// Scans per second to hold while the effects run
+#    define RGB_MATRIX_PACING_SCAN_RATE 1000
+#endif
+
+#ifndef RGB_MATRIX_PACING_MAX_INTERVAL
+// Longest time between the start of two frames, in milliseconds
+#    define RGB_MATRIX_PACING_MAX_INTERVAL 100
+#endif
+
+#ifndef RGB_MATRIX_PACING_REPORT_INTERVAL
+// How often the achieved frame rate is printed over console, in milliseconds
+#    define RGB_MATRIX_PACING_REPORT_INTERVAL 1000
+#endif
+
+/* What was measured over a frame, from its start to the start of the next one. */
+typedef struct {
+    uint32_t frame_time;  // milliseconds between the start of the frame and the next
+    uint32_t render_time; // milliseconds spent rendering the frame
+    uint32_t flush_time;  // milliseconds spent flushing the frame
+    uint16_t scans;       // passes of the scan loop made during the frame
+} rgb_matrix_pacing_frame_t;
+
+/* Starts the governor over, rendering `led_count` LEDs at most `chunk` at a time, one frame every `min_interval`
+ * milliseconds. */
+void rgb_matrix_pacing_init(uint8_t led_count, uint8_t chunk, uint16_t min_interval);
+
+/* Accounts for a frame, and works out the chunk size and interval of the next ones. */
+void rgb_matrix_pacing_update(const rgb_matrix_pacing_frame_t *frame);
+
+/* Number of LEDs to render in each pass of the scan loop. */
+uint8_t rgb_matrix_pacing_chunk(void);
+
+/* Milliseconds between the start of two frames. */
+uint16_t rgb_matrix_pacing_interval(void);
+
+/* Frames started each second, over the last RGB_MATRIX_PACING_REPORT_INTERVAL. */
+uint16_t rgb_matrix_pacing_fps(void);
+
+/* Average time spent rendering and flushing a frame, in microseconds. */
+uint32_t rgb_matrix_pacing_frame_time(void);
@@ -25,6 +25,14 @@
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
+// The effects that read the angle and distance of the LEDs from the center, see rgb_matrix_led_polar()
+#if defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT) || defined(ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL) || \
+    defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT) || defined(ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL) || \
+    defined(ENABLE_RGB_MATRIX_CYCLE_OUT_IN) || defined(ENABLE_RGB_MATRIX_CYCLE_PINWHEEL) || \
+    defined(ENABLE_RGB_MATRIX_CYCLE_SPIRAL)
+#    define RGB_MATRIX_LED_POLAR_TABLE
+#endif
+
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
@@ -73,6 +81,25 @@ typedef struct PACKED {
     uint8_t     flags[RGB_MATRIX_LED_COUNT];
 } led_config_t;
 
+typedef struct PACKED {
+    uint8_t angle; // as atan2_8()
+    uint8_t dist;  // as sqrt16()
+} led_polar_t;
+
+// Polar coordinates of every LED around the center, computed when building from the given center and the table points
+typedef struct PACKED {
+    led_point_t center;
+    led_polar_t polar[RGB_MATRIX_LED_COUNT];
+} led_polar_config_t;
+
+// Position of the distance between two different LEDs in the generated distance table, which stores each pair once, row
+// by row with the larger index first
+static inline uint16_t led_distance_index(uint8_t led_a, uint8_t led_b) {
+    uint8_t row = led_a > led_b ? led_a : led_b;
+    uint8_t col = led_a > led_b ? led_b : led_a;
+    return (uint16_t)row * (row - 1) / 2 + col;
+}
+
 typedef union {
     uint64_t raw;
     struct PACKED {
@@ -0,0 +1,62 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+// rgb_matrix_types.h is a C header
+#define _Static_assert static_assert
+
+extern "C" {
+#include "rgb_matrix_types.h"
+#include "lib/lib8tion/lib8tion.h"
+}
+
+// The same values are expected of the Python ports that compute the generated tables, in
+// lib/python/qmk/tests/test_qmk_generate_keyboard_c.py, so that the tables match what the firmware computes without them
+TEST(LedTables, GeneratorPortsMatchLib8tion) {
+    EXPECT_EQ(atan2_8(0, 1), 0);
+    EXPECT_EQ(atan2_8(0, -1), 128);
+    EXPECT_EQ(atan2_8(1, 0), 64);
+    EXPECT_EQ(atan2_8(-1, 0), 192);
+    EXPECT_EQ(atan2_8(1, 1), 32);
+    EXPECT_EQ(atan2_8(-1, -1), 160);
+    EXPECT_EQ(atan2_8(1, 2), 22);
+    EXPECT_EQ(atan2_8(1, -2), 106);
+    EXPECT_EQ(atan2_8(32, 112), 15);
+    EXPECT_EQ(atan2_8(-32, -112), 143);
+    EXPECT_EQ(atan2_8(223, 143), 38);
+    EXPECT_EQ(atan2_8(-32, 143), 244);
+
+    EXPECT_EQ(sqrt16(0), 0);
+    EXPECT_EQ(sqrt16(1), 1);
+    EXPECT_EQ(sqrt16(24), 4);
+    EXPECT_EQ(sqrt16(25), 5);
+    EXPECT_EQ(sqrt16(13568), 116);
+    EXPECT_EQ(sqrt16(65535), 255);
+    EXPECT_EQ(sqrt16((uint16_t)(65536 + 25)), 5);
+}
+
+TEST(LedTables, DistanceIndexCoversEveryPair) {
+    const uint8_t count = 51;
+
+    // Laid out as the generator writes the table, row by row with the larger index first
+    std::vector<uint16_t> table;
+    for (uint8_t row = 1; row < count; row++) {
+        for (uint8_t col = 0; col < row; col++) {
+            table.push_back(row << 8 | col);
+        }
+    }
+
+    for (uint8_t a = 0; a < count; a++) {
+        for (uint8_t b = 0; b < count; b++) {
+            if (a == b) {
+                continue;
+            }
+            uint16_t index = led_distance_index(a, b);
+            ASSERT_LT(index, table.size());
+            EXPECT_EQ(index, led_distance_index(b, a));
+            EXPECT_EQ(table[index], (a > b ? a << 8 | b : b << 8 | a)) << "LEDs " << int(a) << " and " << int(b);
+        }
+    }
+}
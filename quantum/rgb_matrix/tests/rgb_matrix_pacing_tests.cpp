@@ -0,0 +1,101 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix_pacing.h"
+}
+
+class RgbMatrixPacing : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        rgb_matrix_pacing_init(60, 12, 16);
+    }
+
+    void frame(uint32_t frame_time, uint32_t render_time, uint32_t flush_time, uint16_t scans, int count = 1) {
+        rgb_matrix_pacing_frame_t measured = {frame_time, render_time, flush_time, scans};
+        for (int i = 0; i < count; i++) {
+            rgb_matrix_pacing_update(&measured);
+        }
+    }
+};
+
+TEST_F(RgbMatrixPacing, StartsFromTheConfiguredLimits) {
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 12);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), 16);
+    EXPECT_EQ(rgb_matrix_pacing_fps(), 0);
+    EXPECT_EQ(rgb_matrix_pacing_frame_time(), 0);
+
+    rgb_matrix_pacing_init(60, 0, 16);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 60);
+    rgb_matrix_pacing_init(60, 100, 16);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 60);
+}
+
+TEST_F(RgbMatrixPacing, CheapEffectRendersEverythingAtTheFastestRate) {
+    // 15 ms over 75 passes leaves 800 us of each pass to the effect
+    frame(16, 0, 1, 75);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 60);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), 16);
+}
+
+TEST_F(RgbMatrixPacing, HeavyEffectIsSpreadOverMorePasses) {
+    // 25 ms over 50 passes leaves 500 us of each pass, and rendering takes 200 us per LED
+    frame(40, 12, 3, 50);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 2);
+    // 15 ms of work per frame needs 30 passes of 500 us to keep up 1000 scans a second
+    EXPECT_EQ(rgb_matrix_pacing_interval(), 30);
+    EXPECT_EQ(rgb_matrix_pacing_frame_time(), 15000);
+}
+
+TEST_F(RgbMatrixPacing, SlowLoopBacksOffAsFarAsAllowed) {
+    frame(40, 5, 1, 10);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 1);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), RGB_MATRIX_PACING_MAX_INTERVAL);
+}
+
+TEST_F(RgbMatrixPacing, IntervalIsBounded) {
+    // 150 ms of work per frame would need more time between frames than allowed
+    frame(200, 140, 10, 100);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), RGB_MATRIX_PACING_MAX_INTERVAL);
+
+    // A frame rate limit lower than the governor picks is kept
+    rgb_matrix_pacing_init(60, 12, 33);
+    frame(16, 0, 1, 75);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), 33);
+}
+
+TEST_F(RgbMatrixPacing, FollowsChangingLoadGradually) {
+    frame(16, 0, 1, 75, 10);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 60);
+
+    frame(40, 12, 3, 50);
+    uint8_t chunk = rgb_matrix_pacing_chunk();
+    EXPECT_LT(chunk, 60);
+    EXPECT_GT(chunk, 2);
+
+    frame(40, 12, 3, 50, 30);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 2);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), 30);
+
+    frame(16, 0, 1, 75, 30);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 60);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), 16);
+}
+
+TEST_F(RgbMatrixPacing, FramesWithoutScansAreIgnored) {
+    frame(40, 12, 3, 0);
+    EXPECT_EQ(rgb_matrix_pacing_chunk(), 12);
+    EXPECT_EQ(rgb_matrix_pacing_interval(), 16);
+}
+
+TEST_F(RgbMatrixPacing, ReportsTheAchievedFrameRate) {
+    frame(20, 2, 1, 100, 49);
+    EXPECT_EQ(rgb_matrix_pacing_fps(), 0);
+    frame(20, 2, 1, 100);
+    EXPECT_EQ(rgb_matrix_pacing_fps(), 50);
+
+    frame(16, 2, 1, 100, 63);
+    EXPECT_EQ(rgb_matrix_pacing_fps(), 63);
+}
@@ -0,0 +1,16 @@
+rgb_matrix_pacing_DEFS := -DNO_DEBUG -DNO_PRINT
+
+rgb_matrix_pacing_SRC := \
+    $(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_pacing_tests.cpp \
+    $(QUANTUM_PATH)/rgb_matrix/rgb_matrix_pacing.c
+
+rgb_matrix_pacing_INC := \
+    $(QUANTUM_PATH)/rgb_matrix
+
+led_tables_DEFS := -DMATRIX_ROWS=1 -DMATRIX_COLS=1 -DRGB_MATRIX_LED_COUNT=1
+
+led_tables_SRC := \
+    $(QUANTUM_PATH)/rgb_matrix/tests/led_tables_tests.cpp
+
+led_tables_INC := \
+    $(QUANTUM_PATH)/rgb_matrix
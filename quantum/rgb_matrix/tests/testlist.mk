@@ -0,0 +1,2 @@
+TEST_LIST += rgb_matrix_pacing
+TEST_LIST += led_tables
@@ -0,0 +1,45 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Markers for the individual stages of the scan loop.
+
+    These allow host-side benchmarks to attribute time spent inside keyboard_task() to the stage that consumed it.
+    They compile to nothing unless SCAN_STAGE_HOOKS_ENABLE is defined, in which case whoever enables the hooks must
+    provide implementations of scan_stage_enter() and scan_stage_exit(). When PROFILER_ENABLE is defined and nothing
+    else has claimed the hooks, the profiler implements them and records each stage as a zone.
+
+    Stages may nest -- for example, action_exec() is usually invoked from within matrix_task(), and
+    host_keyboard_send() from within action_exec().
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum scan_stage_t {
+    SCAN_STAGE_MATRIX_TASK,
+    SCAN_STAGE_ACTION_EXEC,
+    SCAN_STAGE_QUANTUM_TASK,
+    SCAN_STAGE_HOST_KEYBOARD_SEND,
+    SCAN_STAGE_COUNT,
+} scan_stage_t;
+
+#if defined(SCAN_STAGE_HOOKS_ENABLE) || defined(PROFILER_ENABLE)
+void scan_stage_enter(scan_stage_t stage);
+void scan_stage_exit(scan_stage_t stage);
+#    define SCAN_STAGE_ENTER(stage) scan_stage_enter(stage)
+#    define SCAN_STAGE_EXIT(stage) scan_stage_exit(stage)
+#else
+#    define SCAN_STAGE_ENTER(stage) \
+        do {                        \
+        } while (0)
+#    define SCAN_STAGE_EXIT(stage) \
+        do {                       \
+        } while (0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
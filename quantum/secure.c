@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "secure.h"
+#include "keyboard.h"
 #include "timer.h"
 #include "util.h"
 
@@ -41,6 +42,7 @@ void secure_lock(void) {
 void secure_unlock(void) {
     secure_status = SECURE_UNLOCKED;
     idle_time     = timer_read32();
+    quantum_task_wake();
     secure_hook(secure_status);
 }
 
@@ -48,6 +50,7 @@ void secure_request_unlock(void) {
     if (secure_status == SECURE_LOCKED) {
         secure_status = SECURE_PENDING;
         unlock_time   = timer_read32();
+        quantum_task_wake();
     }
     secure_hook(secure_status);
 }
@@ -55,6 +58,7 @@ void secure_request_unlock(void) {
 void secure_activity_event(void) {
     if (secure_status == SECURE_UNLOCKED) {
         idle_time = timer_read32();
+        quantum_task_wake();
     }
 }
 
@@ -95,6 +99,24 @@ void secure_task(void) {
 #endif
 }
 
+uint32_t secure_next_deadline(void) {
+#if SECURE_UNLOCK_TIMEOUT != 0
+    if (secure_status == SECURE_PENDING) {
+        uint32_t elapsed = timer_elapsed32(unlock_time);
+        return elapsed >= SECURE_UNLOCK_TIMEOUT ? 0 : SECURE_UNLOCK_TIMEOUT - elapsed;
+    }
+#endif
+
+#if SECURE_IDLE_TIMEOUT != 0
+    if (secure_status == SECURE_UNLOCKED) {
+        uint32_t elapsed = timer_elapsed32(idle_time);
+        return elapsed >= SECURE_IDLE_TIMEOUT ? 0 : SECURE_IDLE_TIMEOUT - elapsed;
+    }
+#endif
+
+    return UINT32_MAX;
+}
+
 __attribute__((weak)) bool secure_hook_user(secure_status_t secure_status) {
     return true;
 }
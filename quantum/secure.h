@@ -71,6 +71,10 @@ void secure_keypress_event(uint8_t row, uint8_t col);
  */
 void secure_task(void);
 
+/** \brief Milliseconds until the next unlock or idle timeout, or UINT32_MAX if none is pending
+ */
+uint32_t secure_next_deadline(void);
+
 /** \brief quantum hook called when changing secure status device
  */
 void secure_hook_quantum(secure_status_t secure_status);
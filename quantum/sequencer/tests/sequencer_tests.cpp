@@ -47,6 +47,7 @@ class SequencerTest : public ::testing::Test {
         state_copy.current_track = sequencer_internal_state.current_track;
         state_copy.current_step  = sequencer_internal_state.current_step;
         state_copy.timer         = sequencer_internal_state.timer;
+        state_copy.phase         = sequencer_internal_state.phase;
 
         last_noteon  = 0;
         last_noteoff = 0;
@@ -72,6 +73,7 @@ class SequencerTest : public ::testing::Test {
         sequencer_internal_state.current_track = state_copy.current_track;
         sequencer_internal_state.current_step  = state_copy.current_step;
         sequencer_internal_state.timer         = state_copy.timer;
+        sequencer_internal_state.phase         = state_copy.phase;
     }
 
     sequencer_config_t config_copy;
@@ -0,0 +1,114 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+extern "C" {
+#include "process_combo.h"
+}
+
+namespace {
+
+std::vector<std::vector<uint16_t>> combo_keys;
+std::vector<combo_t>               combos;
+
+} // namespace
+
+/* Combos are generated at runtime, so that the benchmark can vary how many there are */
+extern "C" uint16_t combo_count(void) {
+    return combos.size();
+}
+
+extern "C" combo_t* combo_get(uint16_t combo_idx) {
+    return &combos[combo_idx];
+}
+
+class ComboBenchmark : public TestFixture, public ::testing::WithParamInterface<size_t> {
+   protected:
+    static constexpr unsigned taps = 5000;
+
+    void SetUp() override {
+        std::mt19937 rng(GetParam());
+
+        // Two and three key combos over the 40 keys of the test matrix
+        combo_keys.clear();
+        combos.clear();
+        for (size_t i = 0; i < GetParam(); i++) {
+            std::vector<uint16_t> keys;
+            while (keys.size() < 2 + i % 2) {
+                uint16_t key = KC_A + rng() % (MATRIX_ROWS * MATRIX_COLS);
+                if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+                    keys.push_back(key);
+                }
+            }
+            keys.push_back(COMBO_END);
+            combo_keys.push_back(keys);
+        }
+        for (auto& keys : combo_keys) {
+            combos.push_back(COMBO(keys, KC_NO));
+        }
+#if COMBO_INDEX_SIZE > 0
+        combo_index_invalidate();
+#endif
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, KC_A + row * MATRIX_COLS + col));
+            }
+        }
+    }
+
+    void TearDown() override {
+        combos.clear();
+    }
+};
+
+TEST_P(ComboBenchmark, RandomTaps) {
+    TestDriver      driver;
+    std::mt19937    rng(1);
+    BenchmarkSeries press, release;
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    // Keys are fed straight to process_combo(), and each is released before the next is pressed
+    for (unsigned i = 0; i < taps; i++) {
+        uint8_t     row = rng() % MATRIX_ROWS, col = rng() % MATRIX_COLS;
+        keyrecord_t record = {};
+        record.event.key   = keypos_t{.col = col, .row = row};
+        record.event.type  = KEY_EVENT;
+
+        record.event.pressed = true;
+        record.event.time    = timer_read();
+        BenchmarkStopwatch stopwatch;
+        process_combo(KC_A + row * MATRIX_COLS + col, &record);
+        press.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+
+        record.event.pressed = false;
+        record.event.time    = timer_read();
+        stopwatch.restart();
+        process_combo(KC_A + row * MATRIX_COLS + col, &record);
+        release.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+    }
+    VERIFY_AND_CLEAR(driver);
+
+#if COMBO_INDEX_SIZE > 0
+    BenchmarkReport report("combo.indexed_" + std::to_string(GetParam()));
+#else
+    BenchmarkReport report("combo.linear_" + std::to_string(GetParam()));
+#endif
+    report.add("combos", GetParam());
+    report.add("taps", taps);
+    report.add_series("press", press);
+    report.add_series("release", release);
+    report.emit();
+}
+
+INSTANTIATE_TEST_CASE_P(ComboCounts, ComboBenchmark, ::testing::Values(16, 64, 256), [](const ::testing::TestParamInfo<size_t>& info) { return "Combos" + std::to_string(info.param); });
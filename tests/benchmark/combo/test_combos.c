@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Placeholder only, the benchmark supplies its own combos through combo_count() and combo_get()
+uint16_t const placeholder_combo[] = {KC_A, KC_B, COMBO_END};
+
+combo_t key_combos[] = {COMBO(placeholder_combo, KC_NO)};
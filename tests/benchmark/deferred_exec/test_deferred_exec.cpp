@@ -0,0 +1,90 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark_util.hpp"
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+uint32_t executions = 0;
+
+uint32_t repeating_callback(uint32_t trigger_time, void* cb_arg) {
+    executions++;
+    return (uint32_t)(uintptr_t)cb_arg;
+}
+
+} // namespace
+
+class DeferredExecBenchmark : public ::testing::TestWithParam<size_t> {
+   protected:
+    static constexpr uint32_t duration_ms = 5000;
+
+    void SetUp() override {
+        set_time(1);
+        executions = 0;
+    }
+};
+
+TEST_P(DeferredExecBenchmark, RepeatingExecutors) {
+    const size_t                     count = GetParam();
+    std::vector<deferred_executor_t> table(count);
+    std::vector<deferred_token>      tokens;
+    std::mt19937                     rng(count);
+    uint32_t                         last_execution = timer_read32();
+
+    BenchmarkSeries queue, task, next_deadline, cancel;
+
+    // Executors repeat every 10-500ms, with a random initial phase
+    for (size_t i = 0; i < count; i++) {
+        uintptr_t          period = 10 + rng() % 491;
+        BenchmarkStopwatch stopwatch;
+        deferred_token     token = defer_exec_advanced(table.data(), count, 1 + rng() % period, repeating_callback, (void*)period);
+        queue.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        tokens.push_back(token);
+    }
+
+    for (uint32_t ms = 0; ms < duration_ms; ms++) {
+        advance_time(1);
+
+        BenchmarkStopwatch stopwatch;
+        deferred_exec_advanced_task(table.data(), count, &last_execution);
+        task.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+
+        stopwatch.restart();
+        uint32_t deadline = deferred_exec_advanced_next_deadline(table.data(), count);
+        next_deadline.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        ASSERT_GT(deadline, 0);
+    }
+
+    for (deferred_token token : tokens) {
+        BenchmarkStopwatch stopwatch;
+        bool               cancelled = cancel_deferred_exec_advanced(table.data(), count, token);
+        cancel.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        EXPECT_TRUE(cancelled);
+    }
+    EXPECT_EQ(deferred_exec_advanced_next_deadline(table.data(), count), UINT32_MAX);
+
+    BenchmarkReport report("deferred_exec.executors_" + std::to_string(count));
+    report.add("executors", count);
+    report.add("duration_ms", duration_ms);
+    report.add("executions", executions);
+    report.add_series("defer_exec", queue);
+    report.add_series("task", task);
+    report.add_series("next_deadline", next_deadline);
+    report.add_series("cancel", cancel);
+    report.emit();
+}
+
+INSTANTIATE_TEST_CASE_P(TableSizes, DeferredExecBenchmark, ::testing::Values(8, 64, 255), [](const ::testing::TestParamInfo<size_t>& info) { return "Executors" + std::to_string(info.param); });
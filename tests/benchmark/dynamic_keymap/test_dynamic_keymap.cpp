@@ -0,0 +1,126 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "benchmark_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+
+extern uint32_t eeprom_test_read_transactions;
+extern uint32_t eeprom_test_write_transactions;
+extern uint32_t eeprom_test_bytes_written;
+void            eeprom_test_reset_counters(void);
+}
+
+namespace {
+
+/* The unmirrored upload, for comparison: every byte is its own EEPROM update */
+void reference_set_buffer(uint16_t offset, uint16_t size, const uint8_t* data) {
+    uint8_t* target = (uint8_t*)dynamic_keymap_key_to_eeprom_address(0, 0, 0) + offset;
+    for (uint16_t i = 0; i < size; i++) {
+        eeprom_update_byte(target + i, data[i]);
+    }
+}
+
+uint16_t reference_get_keycode(uint8_t layer, uint8_t row, uint8_t col) {
+    const uint8_t* address = (const uint8_t*)dynamic_keymap_key_to_eeprom_address(layer, row, col);
+    return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+}
+
+} // namespace
+
+class DynamicKeymapBenchmark : public TestFixture {
+   protected:
+    static constexpr unsigned uploads    = 100;
+    static constexpr uint16_t chunk_size = 28;
+
+    TestDriver driver;
+
+    uint16_t layout_size() {
+        return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+    }
+};
+
+TEST_F(DynamicKeymapBenchmark, LayoutUpload) {
+    const uint16_t       size = layout_size();
+    std::vector<uint8_t> layout(size);
+    std::mt19937         rng(8);
+    BenchmarkSeries      reference, mirrored, flush;
+    uint32_t             reference_writes = 0, mirrored_writes = 0, reference_bytes = 0, mirrored_bytes = 0;
+
+    for (unsigned upload = 0; upload < uploads; upload++) {
+        std::generate(layout.begin(), layout.end(), [&]() { return (uint8_t)rng(); });
+
+        // Upload in chunks, as VIA does, then let the commit delay run out
+        eeprom_test_reset_counters();
+        BenchmarkStopwatch stopwatch;
+        for (uint16_t offset = 0; offset < size; offset += chunk_size) {
+            dynamic_keymap_set_buffer(offset, MIN(chunk_size, size - offset), &layout[offset]);
+        }
+        mirrored.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        ASSERT_EQ(eeprom_test_write_transactions, 0);
+
+        stopwatch.restart();
+        dynamic_keymap_flush();
+        flush.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        mirrored_writes += eeprom_test_write_transactions;
+        mirrored_bytes += eeprom_test_bytes_written;
+
+        // The same upload again without the mirror. The data matches what was just flushed, so the mirror stays in sync.
+        eeprom_test_reset_counters();
+        stopwatch.restart();
+        for (uint16_t offset = 0; offset < size; offset += chunk_size) {
+            reference_set_buffer(offset, MIN(chunk_size, size - offset), &layout[offset]);
+        }
+        reference.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        reference_writes += eeprom_test_write_transactions;
+        reference_bytes += eeprom_test_bytes_written;
+    }
+
+    BenchmarkReport report("dynamic_keymap.layout_upload");
+    report.add("layout_bytes", size);
+    report.add("uploads", uploads);
+    report.add("reference_write_transactions", reference_writes);
+    report.add("reference_bytes_written", reference_bytes);
+    report.add("mirrored_write_transactions", mirrored_writes);
+    report.add("mirrored_bytes_written", mirrored_bytes);
+    report.add_series("reference", reference);
+    report.add_series("mirrored", mirrored);
+    report.add_series("flush", flush);
+    report.emit();
+}
+
+TEST_F(DynamicKeymapBenchmark, KeycodeReads) {
+    std::mt19937    rng(16);
+    BenchmarkSeries reference, mirrored;
+
+    eeprom_test_reset_counters();
+    uint32_t mirrored_reads = 0;
+    for (unsigned i = 0; i < 10000; i++) {
+        uint8_t layer = rng() % dynamic_keymap_get_layer_count(), row = rng() % MATRIX_ROWS, col = rng() % MATRIX_COLS;
+
+        BenchmarkStopwatch stopwatch;
+        uint16_t           expected = reference_get_keycode(layer, row, col);
+        reference.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+
+        uint32_t reads = eeprom_test_read_transactions;
+        stopwatch.restart();
+        uint16_t keycode = dynamic_keymap_get_keycode(layer, row, col);
+        mirrored.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        mirrored_reads += eeprom_test_read_transactions - reads;
+
+        ASSERT_EQ(keycode, expected);
+    }
+
+    BenchmarkReport report("dynamic_keymap.keycode_reads");
+    report.add("lookups", reference.count());
+    report.add("mirrored_read_transactions", mirrored_reads);
+    report.add_series("reference", reference);
+    report.add_series("mirrored", mirrored);
+    report.emit();
+}
@@ -0,0 +1,101 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <random>
+#include <string>
+#include "benchmark_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "action_layer.h"
+}
+
+namespace {
+
+uint32_t reference_keymap_reads = 0;
+
+/* The uncached lookup, for comparison */
+uint8_t reference_layer(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            reference_keymap_reads++;
+            if (action_for_key(i, key).code != ACTION_TRANSPARENT) {
+                return i;
+            }
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+class LayerResolutionBenchmark : public TestFixture {
+   protected:
+    static constexpr unsigned iterations = 5000;
+
+    BenchmarkSeries reference, cached;
+
+    void SetUp() override {
+        // Every key is opaque on the base layer, and on at most one of the 31 layers above it
+        for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                bool opaque = layer == 0 || layer == col * 3;
+                add_key(KeymapKey(layer, col, 0, opaque ? KC_A + col : KC_TRNS));
+            }
+        }
+        reference_keymap_reads = 0;
+    }
+
+    void TearDown() override {
+        layer_clear();
+    }
+
+    void lookup(uint8_t col) {
+        keypos_t key = {.col = col, .row = 0};
+
+        BenchmarkStopwatch stopwatch;
+        uint8_t            expected = reference_layer(key);
+        reference.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+
+        stopwatch.restart();
+        uint8_t layer = layer_switch_get_layer(key);
+        cached.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+
+        ASSERT_EQ(layer, expected);
+    }
+
+    void run_workload(const std::string& name, const std::function<void(unsigned)>& script) {
+        for (unsigned i = 0; i < iterations; i++) {
+            script(i);
+        }
+
+        BenchmarkReport report("layer_resolution." + name);
+        report.add("layers", MAX_LAYER);
+        report.add("lookups", reference.count());
+        report.add("reference_keymap_reads", reference_keymap_reads);
+        report.add_series("reference", reference);
+        report.add_series("cached", cached);
+        report.emit();
+    }
+};
+
+TEST_F(LayerResolutionBenchmark, AllLayersActive) {
+    layer_state_set(~(layer_state_t)1);
+
+    run_workload("all_layers_active", [&](unsigned i) { lookup(i % MATRIX_COLS); });
+}
+
+TEST_F(LayerResolutionBenchmark, LayerToggles) {
+    std::mt19937 rng(32);
+
+    // A layer changes before every few key presses, as when typing with layer keys held
+    run_workload("layer_toggles", [&](unsigned i) {
+        if (i % 4 == 0) {
+            layer_invert(1 + rng() % (MAX_LAYER - 1));
+        }
+        lookup(rng() % MATRIX_COLS);
+    });
+}
@@ -0,0 +1,81 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "benchmark_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::NiceMock;
+
+class ProcessRecordBenchmark : public TestFixture {
+   protected:
+    static constexpr unsigned taps = 20000;
+
+    void SetUp() override {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, KC_A + row * MATRIX_COLS + col));
+            }
+        }
+    }
+
+    /* Taps keycodes picked at random from the given ones, timing each call of process */
+    template <typename Process>
+    void run(const char *name, const std::vector<uint16_t> &keycodes, Process process) {
+        NiceMock<TestDriver> driver;
+        std::mt19937         rng(1);
+        BenchmarkSeries      press, release;
+
+        for (unsigned i = 0; i < taps; i++) {
+            uint16_t    keycode = keycodes[rng() % keycodes.size()];
+            keyrecord_t record  = {};
+            record.event.key    = keypos_t{.col = 0, .row = 0};
+            record.event.type   = KEY_EVENT;
+
+            record.event.pressed = true;
+            record.event.time    = timer_read();
+            BenchmarkStopwatch stopwatch;
+            process(keycode, &record);
+            press.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+
+            record.event.pressed = false;
+            record.event.time    = timer_read();
+            stopwatch.restart();
+            process(keycode, &record);
+            release.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+        }
+
+        BenchmarkReport report(name);
+        report.add("taps", taps);
+        report.add_series("press", press);
+        report.add_series("release", release);
+        report.add("events_per_sec", 2 * taps * UINT64_C(1000000000) / std::max<uint64_t>(press.total_ns() + release.total_ns(), 1));
+        report.emit();
+    }
+};
+
+/* Letters and digits, which every range-only handler can skip */
+static const std::vector<uint16_t> typing = {KC_A, KC_E, KC_I, KC_N, KC_O, KC_R, KC_S, KC_T, KC_1, KC_2, KC_SPACE, KC_ENTER};
+
+/* Keycodes owned by the features, each of which has to reach its handler */
+static const std::vector<uint16_t> feature = {QK_PROGRAMMABLE_BUTTON_1, QK_DYNAMIC_TAPPING_TERM_PRINT, QK_MAGIC_TOGGLE_NKRO, QK_GRAVE_ESCAPE, QK_UNICODE_MODE_NEXT};
+
+TEST_F(ProcessRecordBenchmark, HandlersTyping) {
+    run("process_record.handlers.typing", typing, [](uint16_t keycode, keyrecord_t *record) { process_record_handlers(keycode, record); });
+}
+
+TEST_F(ProcessRecordBenchmark, HandlersFeatureKeycodes) {
+    run("process_record.handlers.feature", feature, [](uint16_t keycode, keyrecord_t *record) { process_record_handlers(keycode, record); });
+}
+
+TEST_F(ProcessRecordBenchmark, QuantumTyping) {
+    run("process_record.quantum.typing", typing, [](uint16_t keycode, keyrecord_t *record) {
+        record->keycode = keycode;
+        process_record_quantum(record);
+    });
+}
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAPPING_TERM 200
+
+// Route the scan loop stage markers into the benchmark's recorder.
+#define SCAN_STAGE_HOOKS_ENABLE
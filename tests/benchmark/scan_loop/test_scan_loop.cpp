@@ -0,0 +1,219 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <functional>
+#include <string>
+#include "benchmark_util.hpp"
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "scan_stage.h"
+}
+
+using testing::NiceMock;
+
+namespace {
+
+/* Must match the order of scan_stage_t */
+const char* const stage_names[SCAN_STAGE_COUNT] = {"matrix_task", "action_exec", "quantum_task", "host_keyboard_send"};
+
+/* Records the inclusive time of the outermost invocation of each stage. Nested
+ * re-entry of the same stage (e.g. combos firing action_exec from within
+ * action_exec) is attributed to the outer invocation. */
+struct StageRecorder {
+    std::array<unsigned, SCAN_STAGE_COUNT>           depth{};
+    std::array<BenchmarkStopwatch, SCAN_STAGE_COUNT> stopwatch{};
+    std::array<BenchmarkSeries, SCAN_STAGE_COUNT>    series{};
+
+    void reset() {
+        depth.fill(0);
+        for (auto& s : series) s.clear();
+    }
+};
+
+StageRecorder recorder;
+
+} // namespace
+
+extern "C" void scan_stage_enter(scan_stage_t stage) {
+    if (recorder.depth[stage]++ == 0) {
+        recorder.stopwatch[stage].restart();
+    }
+}
+
+extern "C" void scan_stage_exit(scan_stage_t stage) {
+    if (--recorder.depth[stage] == 0) {
+        recorder.series[stage].add(recorder.stopwatch[stage].elapsed_ns(), recorder.stopwatch[stage].elapsed_cycles());
+    }
+}
+
+class ScanLoopBenchmark : public TestFixture {
+   protected:
+    static constexpr unsigned iterations = 200;
+
+    KeymapKey key_a{0, 0, 0, KC_A};
+    KeymapKey key_s{0, 1, 0, KC_S};
+    KeymapKey key_d{0, 2, 0, KC_D};
+    KeymapKey key_f{0, 3, 0, KC_F};
+    KeymapKey key_j{0, 4, 0, KC_J};
+    KeymapKey key_k{0, 5, 0, KC_K};
+    KeymapKey key_ctl_z{0, 6, 0, LCTL_T(KC_Z)};
+    KeymapKey key_sft_x{0, 7, 0, LSFT_T(KC_X)};
+    KeymapKey key_td{0, 8, 0, TD(0)};
+    KeymapKey key_mo{0, 9, 0, MO(1)};
+    KeymapKey key_lt{0, 0, 1, LT(2, KC_SPC)};
+    KeymapKey key_a_l1{1, 0, 0, KC_1};
+    KeymapKey key_s_l1{1, 1, 0, KC_2};
+    KeymapKey key_a_l2{2, 0, 0, KC_LEFT};
+    KeymapKey key_s_l2{2, 1, 0, KC_RIGHT};
+
+    BenchmarkSeries scan_loops;
+
+    void SetUp() override {
+        set_keymap({key_a, key_s, key_d, key_f, key_j, key_k, key_ctl_z, key_sft_x, key_td, key_mo, key_lt, key_a_l1, key_s_l1, key_a_l2, key_s_l2});
+    }
+
+    /* Runs one scan loop, recording its total cost. */
+    void scan() {
+        BenchmarkStopwatch stopwatch;
+        run_one_scan_loop();
+        scan_loops.add(stopwatch.elapsed_ns(), stopwatch.elapsed_cycles());
+    }
+
+    void idle(unsigned ms) {
+        for (unsigned i = 0; i < ms; i++) {
+            scan();
+        }
+    }
+
+    void tap(KeymapKey& key, unsigned hold_ms = 20) {
+        key.press();
+        idle(hold_ms);
+        key.release();
+        idle(20);
+    }
+
+    void run_workload(const std::string& name, const std::function<void()>& script) {
+        NiceMock<TestDriver> driver;
+
+        recorder.reset();
+        scan_loops.clear();
+        for (unsigned i = 0; i < iterations; i++) {
+            script();
+        }
+
+        BenchmarkReport report("scan_loop." + name);
+        report.add("iterations", iterations);
+        report.add_series("keyboard_task", scan_loops);
+        for (int stage = 0; stage < SCAN_STAGE_COUNT; stage++) {
+            report.add_series(stage_names[stage], recorder.series[stage]);
+        }
+        report.emit();
+
+        EXPECT_GT(scan_loops.count(), 0);
+        EXPECT_EQ(recorder.series[SCAN_STAGE_MATRIX_TASK].count(), scan_loops.count());
+        EXPECT_GT(recorder.series[SCAN_STAGE_HOST_KEYBOARD_SEND].count(), 0);
+    }
+};
+
+TEST_F(ScanLoopBenchmark, PlainKeys) {
+    run_workload("plain_keys", [&]() {
+        tap(key_a);
+        tap(key_s);
+        tap(key_d);
+        tap(key_f);
+
+        /* Rolling press of two keys */
+        key_j.press();
+        idle(30);
+        key_k.press();
+        idle(60);
+        key_j.release();
+        idle(30);
+        key_k.release();
+        idle(20);
+    });
+}
+
+TEST_F(ScanLoopBenchmark, ModTaps) {
+    run_workload("mod_taps", [&]() {
+        /* Tapped within the tapping term */
+        tap(key_ctl_z);
+        tap(key_sft_x);
+
+        /* Held past the tapping term, then used as a modifier */
+        key_ctl_z.press();
+        idle(TAPPING_TERM + 10);
+        tap(key_a);
+        key_ctl_z.release();
+        idle(20);
+
+        /* Nested within the tapping term */
+        key_sft_x.press();
+        idle(30);
+        tap(key_s, 10);
+        key_sft_x.release();
+        idle(20);
+    });
+}
+
+TEST_F(ScanLoopBenchmark, Combos) {
+    run_workload("combos", [&]() {
+        key_j.press();
+        idle(5);
+        key_k.press();
+        idle(30);
+        key_j.release();
+        idle(5);
+        key_k.release();
+        idle(20);
+
+        /* Combo keys used on their own */
+        tap(key_j);
+        tap(key_k);
+        tap(key_a);
+    });
+}
+
+TEST_F(ScanLoopBenchmark, TapDance) {
+    run_workload("tap_dance", [&]() {
+        /* Single tap */
+        tap(key_td);
+        idle(TAPPING_TERM);
+
+        /* Double tap */
+        tap(key_td);
+        tap(key_td);
+        idle(TAPPING_TERM);
+
+        /* Interrupted by another key */
+        tap(key_td);
+        tap(key_a);
+    });
+}
+
+TEST_F(ScanLoopBenchmark, Layers) {
+    run_workload("layers", [&]() {
+        key_mo.press();
+        idle(20);
+        tap(key_a);
+        tap(key_s);
+        key_mo.release();
+        idle(20);
+
+        /* Layer tap, held */
+        key_lt.press();
+        idle(TAPPING_TERM + 10);
+        tap(key_a);
+        tap(key_s);
+        key_lt.release();
+        idle(20);
+
+        /* Layer tap, tapped */
+        tap(key_lt);
+    });
+}
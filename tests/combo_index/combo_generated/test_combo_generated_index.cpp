@@ -0,0 +1,83 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "quantum.h"
+#include "keymap_introspection.h"
+
+uint16_t get_combo_term(uint16_t index, combo_t* combo);
+}
+
+namespace {
+
+std::vector<std::pair<uint16_t, uint8_t>> find_refs(uint16_t keycode) {
+    const combo_key_ref_t*                    refs  = nullptr;
+    uint16_t                                  count = UINT16_MAX;
+    std::vector<std::pair<uint16_t, uint8_t>> result;
+
+    EXPECT_TRUE(combo_generated_index_find(keycode, &refs, &count));
+    for (uint16_t i = 0; i < count; i++) {
+        result.emplace_back(refs[i].combo_index, refs[i].key_index);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(ComboGeneratedIndex, ListsCombosContainingKey) {
+    std::vector<std::pair<uint16_t, uint8_t>> expected = {{0, 1}, {1, 1}, {2, 0}};
+    EXPECT_EQ(find_refs(KC_B), expected);
+}
+
+TEST(ComboGeneratedIndex, RepeatedKeyUsesLastPosition) {
+    std::vector<std::pair<uint16_t, uint8_t>> expected = {{3, 1}, {5, 2}};
+    EXPECT_EQ(find_refs(KC_E), expected);
+}
+
+TEST(ComboGeneratedIndex, KeyOutsideCombosHasNoRefs) {
+    EXPECT_TRUE(find_refs(KC_H).empty());
+    EXPECT_TRUE(find_refs(KC_NO).empty());
+    EXPECT_TRUE(find_refs(UINT16_MAX).empty());
+}
+
+TEST(ComboGeneratedIndex, FindsFirstAndLastKey) {
+    std::vector<std::pair<uint16_t, uint8_t>> first = {{0, 0}, {1, 0}};
+    std::vector<std::pair<uint16_t, uint8_t>> last  = {{4, 1}};
+    EXPECT_EQ(find_refs(KC_A), first);
+    EXPECT_EQ(find_refs(KC_G), last);
+}
+
+TEST(ComboGeneratedIndex, UsesGeneratedTerms) {
+    // The shared tests rely on COMBO_TERM, so the one combo with its own term uses the same value
+    EXPECT_EQ(get_combo_term(3, combo_get(3)), 50);
+    EXPECT_EQ(get_combo_term(0, combo_get(0)), COMBO_TERM);
+}
+
+TEST(ComboGeneratedIndex, MatchesCombos) {
+    // Every key of every combo is listed, with the key count of its combo
+    for (uint16_t idx = 0; idx < combo_count(); idx++) {
+        combo_t* combo = combo_get(idx);
+        uint8_t  count = 0;
+        while (combo->keys[count] != COMBO_END) {
+            count++;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            const combo_key_ref_t* refs;
+            uint16_t               ref_count;
+            bool                   found = false;
+            ASSERT_TRUE(combo_generated_index_find(combo->keys[i], &refs, &ref_count));
+            for (uint16_t r = 0; r < ref_count; r++) {
+                if (refs[r].combo_index == idx) {
+                    EXPECT_EQ(combo->keys[refs[r].key_index], combo->keys[i]);
+                    EXPECT_EQ(refs[r].key_count, count);
+                    found = true;
+                }
+            }
+            EXPECT_TRUE(found) << "combo " << idx << " key " << int(i);
+        }
+    }
+}
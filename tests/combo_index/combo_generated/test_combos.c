@@ -0,0 +1,44 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The combos from ../test_combos.c, as generated by qmk json2c from keymap.json. test_json2c_combos_fixture checks that
+// the two stay in step.
+
+#include "quantum.h"
+
+#if defined(COMBO_ENABLE)
+const uint16_t PROGMEM combo_keys_0[] = {KC_A, KC_B, COMBO_END};
+const uint16_t PROGMEM combo_keys_1[] = {KC_A, KC_B, KC_C, COMBO_END};
+const uint16_t PROGMEM combo_keys_2[] = {KC_B, KC_C, COMBO_END};
+const uint16_t PROGMEM combo_keys_3[] = {KC_D, KC_E, COMBO_END};
+const uint16_t PROGMEM combo_keys_4[] = {KC_F, KC_G, COMBO_END};
+const uint16_t PROGMEM combo_keys_5[] = {KC_E, KC_F, KC_E, COMBO_END};
+
+combo_t key_combos[] = {
+    COMBO(combo_keys_0, KC_X),
+    COMBO(combo_keys_1, KC_Y),
+    COMBO(combo_keys_2, KC_Z),
+    COMBO(combo_keys_3, KC_NO),
+    COMBO(combo_keys_4, LSFT_T(KC_V)),
+    COMBO(combo_keys_5, KC_W),
+};
+
+#    define COMBO_GENERATED_INDEX
+const uint16_t PROGMEM combo_index_keycodes[] = {0x0004, 0x0005, 0x0006, 0x0007, 0x0008, 0x0009, 0x000A};
+const uint16_t PROGMEM combo_index_offsets[] = {0, 2, 5, 7, 8, 10, 12, 13};
+const combo_key_ref_t PROGMEM combo_index_refs[] = {
+    {0, 0, 2}, {1, 0, 3}, // KC_A
+    {0, 1, 2}, {1, 1, 3}, {2, 0, 2}, // KC_B
+    {1, 2, 3}, {2, 1, 2}, // KC_C
+    {3, 0, 2}, // KC_D
+    {3, 1, 2}, {5, 2, 3}, // KC_E
+    {4, 0, 2}, {5, 1, 3}, // KC_F
+    {4, 1, 2}, // KC_G
+};
+
+#    if !defined(COMBO_TERM_PER_COMBO)
+#        error "Combos with their own term require COMBO_TERM_PER_COMBO to be defined"
+#    endif
+#    define COMBO_GENERATED_TERMS
+const uint16_t PROGMEM combo_terms[] = {COMBO_TERM, COMBO_TERM, COMBO_TERM, 50, COMBO_TERM, COMBO_TERM};
+#endif // defined(COMBO_ENABLE)
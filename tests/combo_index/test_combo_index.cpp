@@ -0,0 +1,151 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <utility>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+namespace {
+
+std::vector<std::pair<uint16_t, bool>> combo_events;
+
+} // namespace
+
+extern "C" void process_combo_event(uint16_t combo_index, bool pressed) {
+    combo_events.emplace_back(combo_index, pressed);
+}
+
+class ComboIndex : public TestFixture {
+   protected:
+    KeymapKey key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey key_b = KeymapKey(0, 1, 0, KC_B);
+    KeymapKey key_c = KeymapKey(0, 2, 0, KC_C);
+    KeymapKey key_d = KeymapKey(0, 3, 0, KC_D);
+    KeymapKey key_e = KeymapKey(0, 4, 0, KC_E);
+    KeymapKey key_f = KeymapKey(0, 5, 0, KC_F);
+    KeymapKey key_g = KeymapKey(0, 6, 0, KC_G);
+    KeymapKey key_h = KeymapKey(0, 7, 0, KC_H);
+
+    void SetUp() override {
+        set_keymap({key_a, key_b, key_c, key_d, key_e, key_f, key_g, key_h});
+        combo_events.clear();
+    }
+};
+
+TEST_F(ComboIndex, ComboFires) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, LongerOverlappingComboWins) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, ComboActionReportsEvents) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_combo({key_d, key_e});
+    VERIFY_AND_CLEAR(driver);
+
+    std::vector<std::pair<uint16_t, bool>> expected = {{3, true}, {3, false}};
+    EXPECT_EQ(combo_events, expected);
+}
+
+TEST_F(ComboIndex, KeysOutsideCombosPassThrough) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_H));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_h);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, IncompleteComboTimesOut) {
+    TestDriver driver;
+
+    // The combo timer treats a start time of 0 as stopped
+    idle_for(1);
+
+    EXPECT_NO_REPORT(driver);
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    idle_for(COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, RandomTypingMatchesReference) {
+    // Random chords and rolls over the combo keys. The combos are checked the same way with and without the index, so
+    // both builds of this test must produce exactly the same trace of reports and combo events.
+    TestDriver              driver;
+    std::vector<KeymapKey*> keys = {&key_a, &key_b, &key_c, &key_d, &key_e, &key_f, &key_g, &key_h};
+    std::vector<bool>       down(keys.size());
+    std::mt19937            rng(2026);
+    uint32_t                trace = 2166136261u;
+
+    auto hash = [&](uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            trace = (trace ^ ((value >> (i * 8)) & 0xFF)) * 16777619u;
+        }
+    };
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_keyboard_t& report) {
+        hash(timer_read32());
+        hash(report.mods);
+        for (uint8_t key : report.keys) {
+            hash(key);
+        }
+    }));
+
+    for (int step = 0; step < 4000; step++) {
+        size_t i = rng() % keys.size();
+        if (down[i]) {
+            keys[i]->release();
+        } else {
+            keys[i]->press();
+        }
+        down[i] = !down[i];
+        idle_for(1 + rng() % (COMBO_TERM + 10));
+
+        size_t events = combo_events.size();
+        for (auto& event : combo_events) {
+            hash(event.first);
+            hash(event.second);
+        }
+        combo_events.clear();
+        hash(events);
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (down[i]) {
+            keys[i]->release();
+        }
+    }
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(trace, 3115559713u);
+}
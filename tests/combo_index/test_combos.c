@@ -0,0 +1,24 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { ab, abc, bc, de, fg, repeated };
+
+uint16_t const ab_combo[]       = {KC_A, KC_B, COMBO_END};
+uint16_t const abc_combo[]      = {KC_A, KC_B, KC_C, COMBO_END};
+uint16_t const bc_combo[]       = {KC_B, KC_C, COMBO_END};
+uint16_t const de_combo[]       = {KC_D, KC_E, COMBO_END};
+uint16_t const fg_combo[]       = {KC_F, KC_G, COMBO_END};
+uint16_t const repeated_combo[] = {KC_E, KC_F, KC_E, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab]       = COMBO(ab_combo, KC_X),
+    [abc]      = COMBO(abc_combo, KC_Y),
+    [bc]       = COMBO(bc_combo, KC_Z),
+    [de]       = COMBO_ACTION(de_combo),
+    [fg]       = COMBO(fg_combo, LSFT_T(KC_V)),
+    [repeated] = COMBO(repeated_combo, KC_W),
+};
+// clang-format on
@@ -0,0 +1,103 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "action.h"
+#include "keycode_config.h"
+#include "keymap_common.h"
+}
+
+using testing::_;
+
+class DecodedActionCache : public TestFixture {
+   protected:
+    void TearDown() override {
+        keymap_config.swap_lctl_lgui = false;
+        layer_clear();
+    }
+};
+
+TEST_F(DecodedActionCache, MatchesUncachedDecoding) {
+    TestDriver driver;
+    keypos_t   key = {.col = 0, .row = 0};
+
+    set_keymap({KeymapKey(0, 0, 0, LCTL_T(KC_A)), KeymapKey(1, 0, 0, MO(2)), KeymapKey(2, 0, 0, KC_TRNS), KeymapKey(3, 0, 0, OSM(MOD_LSFT))});
+
+    EXPECT_NO_REPORT(driver);
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint8_t layer = 0; layer < 4; layer++) {
+            EXPECT_EQ(action_for_key(layer, key).code, action_for_keycode(keymap_key_to_keycode(layer, key)).code) << "layer " << +layer;
+        }
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DecodedActionCache, KeymapChangesInvalidateCache) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 0, 0, KC_B);
+
+    set_keymap({key_a});
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    set_keymap({key_b});
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DecodedActionCache, KeymapConfigChangesInvalidateCache) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_LCTL);
+
+    set_keymap({key});
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    // Magic keycodes and VIA write keymap_config directly
+    keymap_config.swap_lctl_lgui = true;
+    EXPECT_REPORT(driver, (KC_LGUI));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DecodedActionCache, LayersAboveCacheAreDecodedDirectly) {
+    TestDriver driver;
+    auto       key_mo    = KeymapKey(0, 0, 0, MO(3));
+    auto       key_a     = KeymapKey(0, 1, 0, KC_A);
+    auto       key_mo_l3 = KeymapKey(3, 0, 0, KC_TRNS);
+    auto       key_a_l3  = KeymapKey(3, 1, 0, KC_1);
+
+    set_keymap({key_mo, key_a, key_mo_l3, key_a_l3});
+
+    EXPECT_NO_REPORT(driver);
+    key_mo.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_mo.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
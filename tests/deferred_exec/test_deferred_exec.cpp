@@ -0,0 +1,283 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+struct Job;
+
+using ExecutionLog = std::vector<std::pair<int, uint32_t>>;
+
+struct Job {
+    int           id;
+    uint32_t      repeat_ms;
+    unsigned      repeats;
+    ExecutionLog* log;
+    // Optional side effect run from within the callback
+    void (*action)(Job* job);
+    void* context;
+};
+
+uint32_t job_callback(uint32_t trigger_time, void* cb_arg) {
+    Job* job = static_cast<Job*>(cb_arg);
+    job->log->emplace_back(job->id, timer_read32());
+    if (job->action) {
+        job->action(job);
+    }
+    if (job->repeats > 0) {
+        job->repeats--;
+        return job->repeat_ms;
+    }
+    return 0;
+}
+
+} // namespace
+
+class DeferredExec : public ::testing::Test {
+   public:
+    static constexpr size_t table_size = 16;
+
+    deferred_executor_t table[table_size] = {};
+    uint32_t            last_execution    = 0;
+    ExecutionLog        log;
+
+    void SetUp() override {
+        set_time(1000);
+        last_execution = timer_read32();
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, table_size, &last_execution);
+        }
+    }
+
+    deferred_token defer(Job& job, uint32_t delay_ms) {
+        job.log = &log;
+        return defer_exec_advanced(table, table_size, delay_ms, job_callback, &job);
+    }
+};
+
+TEST_F(DeferredExec, ExecutesInTriggerOrder) {
+    Job jobs[] = {{50}, {10}, {30}, {20}, {40}};
+    for (auto& job : jobs) {
+        EXPECT_NE(defer(job, job.id), INVALID_DEFERRED_TOKEN);
+    }
+
+    run_for(60);
+    ExecutionLog expected = {{10, 1010}, {20, 1020}, {30, 1030}, {40, 1040}, {50, 1050}};
+    EXPECT_EQ(log, expected);
+}
+
+TEST_F(DeferredExec, RepeatingExecutorKeepsCadence) {
+    Job job = {1, 10, 3};
+    defer(job, 5);
+
+    run_for(100);
+    ExecutionLog expected = {{1, 1005}, {1, 1015}, {1, 1025}, {1, 1035}};
+    EXPECT_EQ(log, expected);
+}
+
+TEST_F(DeferredExec, CancelRemovesOnlyThatExecutor) {
+    Job            jobs[] = {{1}, {2}, {3}, {4}};
+    deferred_token tokens[4];
+    for (int i = 0; i < 4; i++) {
+        tokens[i] = defer(jobs[i], 10 * (i + 1));
+    }
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, table_size, tokens[1]));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, table_size, tokens[1]));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, table_size, tokens[0]));
+
+    run_for(50);
+    ExecutionLog expected = {{3, 1030}, {4, 1040}};
+    EXPECT_EQ(log, expected);
+
+    // Already executed
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, table_size, tokens[2]));
+}
+
+TEST_F(DeferredExec, ExtendReordersExecutors) {
+    Job            first = {1}, second = {2};
+    deferred_token token = defer(first, 10);
+    defer(second, 20);
+
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, table_size, token, 30));
+    run_for(40);
+    ExecutionLog expected = {{2, 1020}, {1, 1030}};
+    EXPECT_EQ(log, expected);
+
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, table_size, token, 30));
+}
+
+TEST_F(DeferredExec, FullTableRejectsNewExecutors) {
+    Job jobs[table_size + 1];
+    for (size_t i = 0; i < table_size; i++) {
+        jobs[i] = {int(i)};
+        EXPECT_NE(defer(jobs[i], 10 + i), INVALID_DEFERRED_TOKEN);
+    }
+    jobs[table_size] = {int(table_size)};
+    EXPECT_EQ(defer(jobs[table_size], 5), INVALID_DEFERRED_TOKEN);
+
+    // Once one has executed, its slot is available again
+    run_for(10);
+    EXPECT_NE(defer(jobs[table_size], 5), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExec, TokensAreNotImmediatelyReused) {
+    Job            job   = {1};
+    deferred_token first = defer(job, 10);
+    cancel_deferred_exec_advanced(table, table_size, first);
+
+    deferred_token second = defer(job, 10);
+    EXPECT_NE(second, INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(second, first);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, table_size, first));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, table_size, second));
+}
+
+TEST_F(DeferredExec, NextDeadlineTracksEarliestExecutor) {
+    EXPECT_EQ(deferred_exec_advanced_next_deadline(table, table_size), UINT32_MAX);
+
+    Job            early = {1}, late = {2};
+    deferred_token token = defer(early, 20);
+    defer(late, 50);
+    EXPECT_EQ(deferred_exec_advanced_next_deadline(table, table_size), 20);
+
+    advance_time(5);
+    EXPECT_EQ(deferred_exec_advanced_next_deadline(table, table_size), 15);
+
+    cancel_deferred_exec_advanced(table, table_size, token);
+    EXPECT_EQ(deferred_exec_advanced_next_deadline(table, table_size), 45);
+
+    advance_time(60);
+    EXPECT_EQ(deferred_exec_advanced_next_deadline(table, table_size), 0);
+}
+
+TEST_F(DeferredExec, CallbackMayRequeueItselfAndOthers) {
+    struct Context {
+        DeferredExec*  fixture;
+        Job*           other;
+        deferred_token other_token;
+        Job*           spawned;
+    };
+
+    Job     spawned = {3};
+    Job     other   = {2};
+    Job     first   = {1};
+    Context context = {this, &other, INVALID_DEFERRED_TOKEN, &spawned};
+
+    first.context = &context;
+    first.action  = [](Job* job) {
+        auto* ctx = static_cast<Context*>(job->context);
+        cancel_deferred_exec_advanced(ctx->fixture->table, table_size, ctx->other_token);
+        ctx->fixture->defer(*ctx->spawned, 5);
+        // Re-queue with a fresh token, rather than by returning a delay
+        cancel_deferred_exec_advanced(ctx->fixture->table, table_size, ctx->fixture->defer(*job, 1));
+        ctx->fixture->defer(*job, 20);
+    };
+
+    defer(first, 10);
+    context.other_token = defer(other, 12);
+
+    run_for(40);
+    ExecutionLog expected = {{1, 1010}, {3, 1015}, {1, 1030}};
+    // The re-queued job runs its action again, spawning another executor
+    expected.emplace_back(3, 1035);
+    EXPECT_EQ(log, expected);
+}
+
+TEST_F(DeferredExec, MatchesReferenceModel) {
+    // Random sequences of operations, compared against a straightforward model of the expected behaviour
+    std::mt19937                   rng(1234);
+    std::map<deferred_token, Job*> live;
+    std::vector<Job>               jobs(4096);
+    std::map<int, uint32_t>        due;
+    size_t                         next_job = 0;
+
+    for (int step = 0; step < 2000 && next_job < jobs.size(); step++) {
+        switch (rng() % 4) {
+            case 0:
+            case 1: {
+                Job& job = jobs[next_job];
+                job      = {int(next_job++)};
+
+                uint32_t       delay = 1 + rng() % 40;
+                deferred_token t     = defer(job, delay);
+                if (live.size() < table_size) {
+                    ASSERT_NE(t, INVALID_DEFERRED_TOKEN);
+                    live[t]     = &job;
+                    due[job.id] = timer_read32() + delay;
+                } else {
+                    ASSERT_EQ(t, INVALID_DEFERRED_TOKEN);
+                }
+                break;
+            }
+            case 2:
+                if (!live.empty()) {
+                    auto it = std::next(live.begin(), rng() % live.size());
+                    ASSERT_TRUE(cancel_deferred_exec_advanced(table, table_size, it->first));
+                    due.erase(it->second->id);
+                    live.erase(it);
+                }
+                break;
+            case 3:
+                if (!live.empty()) {
+                    auto     it    = std::next(live.begin(), rng() % live.size());
+                    uint32_t delay = 1 + rng() % 40;
+                    ASSERT_TRUE(extend_deferred_exec_advanced(table, table_size, it->first, delay));
+                    due[it->second->id] = timer_read32() + delay;
+                }
+                break;
+        }
+
+        uint32_t earliest = UINT32_MAX;
+        for (auto& entry : due) {
+            earliest = std::min(earliest, entry.second - timer_read32());
+        }
+        ASSERT_EQ(deferred_exec_advanced_next_deadline(table, table_size), earliest);
+
+        // Advance time, checking the set of executors run each millisecond
+        uint32_t ms = rng() % 4;
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            size_t before = log.size();
+            deferred_exec_advanced_task(table, table_size, &last_execution);
+
+            std::vector<int> ran;
+            for (size_t j = before; j < log.size(); j++) {
+                ran.push_back(log[j].first);
+            }
+            std::vector<int> should_run;
+            for (auto& entry : due) {
+                if (entry.second == timer_read32()) {
+                    should_run.push_back(entry.first);
+                }
+            }
+            std::sort(ran.begin(), ran.end());
+            ASSERT_EQ(ran, should_run);
+
+            for (int id : should_run) {
+                due.erase(id);
+            }
+            for (auto it = live.begin(); it != live.end();) {
+                it = due.count(it->second->id) ? std::next(it) : live.erase(it);
+            }
+        }
+    }
+}
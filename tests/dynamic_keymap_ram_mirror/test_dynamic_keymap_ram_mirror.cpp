@@ -0,0 +1,137 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeconfig.h"
+#include "eeprom.h"
+
+extern uint32_t eeprom_test_write_transactions;
+void            eeprom_test_reset_counters(void);
+}
+
+class DynamicKeymapRamMirror : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        dynamic_keymap_flush();
+        eeprom_test_reset_counters();
+    }
+
+    void TearDown() override {
+        dynamic_keymap_flush();
+    }
+
+    uint16_t stored_keycode(uint8_t layer, uint8_t row, uint8_t col) {
+        const uint8_t *address = (const uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, col);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(DynamicKeymapRamMirror, WritesAreServedFromRamUntilCommitted) {
+    uint16_t original = dynamic_keymap_get_keycode(0, 1, 2);
+    uint16_t keycode  = original == KC_B ? KC_C : KC_B;
+
+    dynamic_keymap_set_keycode(0, 1, 2, keycode);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), keycode);
+    EXPECT_EQ(stored_keycode(0, 1, 2), original);
+    EXPECT_EQ(dynamic_keymap_next_deadline(), DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY);
+
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY);
+    EXPECT_EQ(eeprom_test_write_transactions, 0);
+    EXPECT_EQ(stored_keycode(0, 1, 2), original);
+
+    idle_for(1);
+    EXPECT_EQ(eeprom_test_write_transactions, 1);
+    EXPECT_EQ(stored_keycode(0, 1, 2), keycode);
+    EXPECT_EQ(dynamic_keymap_next_deadline(), UINT32_MAX);
+}
+
+TEST_F(DynamicKeymapRamMirror, FurtherWritesPostponeCommit) {
+    uint16_t keycode = dynamic_keymap_get_keycode(1, 0, 0) == KC_X ? KC_Y : KC_X;
+
+    dynamic_keymap_set_keycode(1, 0, 0, keycode);
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY / 2);
+    dynamic_keymap_set_keycode(1, 3, 9, keycode);
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY);
+    EXPECT_EQ(eeprom_test_write_transactions, 0);
+
+    idle_for(1);
+    EXPECT_EQ(stored_keycode(1, 0, 0), keycode);
+    EXPECT_EQ(stored_keycode(1, 3, 9), keycode);
+}
+
+TEST_F(DynamicKeymapRamMirror, UnchangedWritesAreNotCommitted) {
+    uint16_t keycode = dynamic_keymap_get_keycode(2, 2, 2);
+
+    dynamic_keymap_set_keycode(2, 2, 2, keycode);
+    EXPECT_EQ(dynamic_keymap_next_deadline(), UINT32_MAX);
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY + 1);
+    EXPECT_EQ(eeprom_test_write_transactions, 0);
+}
+
+TEST_F(DynamicKeymapRamMirror, LayoutUploadIsCoalesced) {
+    const uint16_t       size = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+    std::vector<uint8_t> layout(size), readback(size);
+    for (uint16_t i = 0; i < size; i++) {
+        layout[i] = i * 7 + 3;
+    }
+
+    // Uploaded in 28 byte chunks, as VIA does
+    for (uint16_t offset = 0; offset < size; offset += 28) {
+        dynamic_keymap_set_buffer(offset, MIN(28, size - offset), &layout[offset]);
+        idle_for(1);
+    }
+    dynamic_keymap_get_buffer(0, size, readback.data());
+    EXPECT_EQ(readback, layout);
+    EXPECT_EQ(eeprom_test_write_transactions, 0);
+
+    // The whole keymap is contiguous, so it is written back in one go
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY);
+    EXPECT_EQ(eeprom_test_write_transactions, 1);
+    for (uint16_t i = 0; i < size; i++) {
+        ASSERT_EQ(eeprom_read_byte((const uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 0, 0) + i), layout[i]);
+    }
+}
+
+TEST_F(DynamicKeymapRamMirror, FlushWritesOnlyDirtyRuns) {
+    uint16_t first  = dynamic_keymap_get_keycode(0, 0, 0) == KC_Q ? KC_W : KC_Q;
+    uint16_t second = dynamic_keymap_get_keycode(3, 3, 9) == KC_Q ? KC_W : KC_Q;
+
+    dynamic_keymap_set_keycode(0, 0, 0, first);
+    dynamic_keymap_set_keycode(3, 3, 9, second);
+    dynamic_keymap_flush();
+    EXPECT_EQ(eeprom_test_write_transactions, 2);
+    EXPECT_EQ(stored_keycode(0, 0, 0), first);
+    EXPECT_EQ(stored_keycode(3, 3, 9), second);
+    EXPECT_EQ(dynamic_keymap_next_deadline(), UINT32_MAX);
+
+    dynamic_keymap_flush();
+    EXPECT_EQ(eeprom_test_write_transactions, 2);
+}
+
+TEST_F(DynamicKeymapRamMirror, EepromResetDiscardsOutstandingChanges) {
+    uint16_t original = dynamic_keymap_get_keycode(1, 2, 3);
+    uint16_t keycode  = original == KC_Z ? KC_X : KC_Z;
+
+    dynamic_keymap_set_keycode(1, 2, 3, keycode);
+    eeconfig_disable();
+    EXPECT_EQ(dynamic_keymap_next_deadline(), UINT32_MAX);
+    eeprom_test_reset_counters();
+    idle_for(DYNAMIC_KEYMAP_RAM_MIRROR_COMMIT_DELAY + 1);
+    dynamic_keymap_flush();
+    EXPECT_EQ(eeprom_test_write_transactions, 0);
+    EXPECT_EQ(stored_keycode(1, 2, 3), original);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), original);
+
+    // Also when EEPROM is reinitialised, with the mirror reloaded from what was written
+    dynamic_keymap_set_keycode(1, 2, 3, keycode);
+    eeconfig_init();
+    dynamic_keymap_flush();
+    EXPECT_EQ(stored_keycode(1, 2, 3), original);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), original);
+}
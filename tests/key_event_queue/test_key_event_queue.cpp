@@ -0,0 +1,181 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "key_event_queue.h"
+
+void advance_time(uint32_t ms);
+
+/* Simulates a process_record chain that takes slow_key_delay milliseconds for KC_F24 */
+static uint32_t slow_key_delay = 0;
+
+static std::vector<keyevent_t> seen_events;
+
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record) {
+    seen_events.push_back(record->event);
+    if (keycode == KC_F24) {
+        advance_time(slow_key_delay);
+    }
+    return true;
+}
+}
+
+using testing::_;
+using testing::InSequence;
+
+class KeyEventQueue : public TestFixture {
+   protected:
+    void SetUp() override {
+        slow_key_delay = 0;
+        seen_events.clear();
+        key_event_queue_reset_stats();
+    }
+};
+
+TEST_F(KeyEventQueue, EventsCarryTheScanTime) {
+    TestDriver driver;
+    auto       slow_key = KeymapKey(0, 0, 0, KC_F24);
+    auto       key_a    = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({slow_key, key_a});
+    slow_key_delay = 50;
+
+    EXPECT_REPORT(driver, (KC_F24));
+    EXPECT_REPORT(driver, (KC_F24, KC_A));
+    const uint16_t scan_time = timer_read();
+    slow_key.press();
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The second event was processed after the first took 50ms, but happened at the same time
+    ASSERT_EQ(seen_events.size(), 2);
+    EXPECT_EQ(seen_events[0].time, scan_time);
+    EXPECT_EQ(seen_events[1].time, scan_time);
+    EXPECT_GE(timer_read(), (uint16_t)(scan_time + 50));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    slow_key.release();
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, TapDecidedByPressTimes) {
+    TestDriver driver;
+    InSequence s;
+    auto       slow_key = KeymapKey(0, 0, 0, KC_F24);
+    auto       mod_tap  = KeymapKey(0, 1, 0, LSFT_T(KC_P));
+
+    set_keymap({slow_key, mod_tap});
+    slow_key_delay = 100;
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM - 50);
+    VERIFY_AND_CLEAR(driver);
+
+    // Released within the tapping term, but only processed after it has passed
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_REPORT(driver, (KC_P, KC_F24));
+    EXPECT_REPORT(driver, (KC_F24));
+    slow_key.press();
+    mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    slow_key_delay = 0;
+    slow_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, OverflowDefersToNextScan) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f = KeymapKey(0, 5, 0, KC_F);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    key_d.press();
+    key_e.press();
+    key_f.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_event_queue_stats_t stats = key_event_queue_stats();
+    EXPECT_EQ(stats.depth, 0);
+    EXPECT_EQ(stats.max_depth, KEY_EVENT_QUEUE_SIZE);
+    EXPECT_EQ(stats.overflows, 2);
+    EXPECT_EQ(stats.pushed, 4);
+
+    // The keys that did not fit are found again by the next scan
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E, KC_F));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    stats = key_event_queue_stats();
+    EXPECT_EQ(stats.overflows, 2);
+    EXPECT_EQ(stats.pushed, 6);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    key_e.release();
+    key_f.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+static keyevent_t key_press(uint8_t row, uint8_t col) {
+    keyevent_t event = {};
+    event.key        = {.col = col, .row = row};
+    event.type       = KEY_EVENT;
+    event.pressed    = true;
+    return event;
+}
+
+TEST_F(KeyEventQueue, PushAndPop) {
+    keyevent_t event;
+
+    EXPECT_FALSE(key_event_queue_pop(&event));
+    for (uint8_t i = 0; i < KEY_EVENT_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(key_event_queue_push(key_press(0, i)));
+    }
+    EXPECT_FALSE(key_event_queue_push(key_press(1, 0)));
+    EXPECT_EQ(key_event_queue_depth(), KEY_EVENT_QUEUE_SIZE);
+
+    for (uint8_t i = 0; i < KEY_EVENT_QUEUE_SIZE; i++) {
+        ASSERT_TRUE(key_event_queue_pop(&event));
+        EXPECT_EQ(event.key.col, i);
+    }
+    EXPECT_FALSE(key_event_queue_pop(&event));
+    EXPECT_EQ(key_event_queue_stats().overflows, 1);
+}
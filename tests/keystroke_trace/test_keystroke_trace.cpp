@@ -0,0 +1,233 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <fstream>
+#include "benchmark_util.hpp"
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "keystroke_trace_replay.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+void set_time(uint32_t t);
+}
+
+class KeystrokeTrace : public TestFixture {
+   protected:
+    void TearDown() override {
+        keystroke_trace_stop();
+        drain();
+    }
+
+    std::vector<uint8_t> drain() {
+        std::vector<uint8_t> bytes(keystroke_trace_available());
+        bytes.resize(keystroke_trace_read(bytes.data(), bytes.size()));
+        return bytes;
+    }
+
+    void record_tick() {
+        keystroke_trace_record({.key = {.col = 0, .row = 0}, .time = timer_read(), .type = TICK_EVENT, .pressed = false});
+    }
+
+    void record_key(uint8_t row, uint8_t col, bool pressed, uint8_t age = 0) {
+        keystroke_trace_record({.key = {.col = col, .row = row}, .time = (uint16_t)(timer_read() - age), .type = KEY_EVENT, .pressed = pressed});
+    }
+};
+
+TEST_F(KeystrokeTrace, EncodesTicksTimeAndEvents) {
+    set_time(1000);
+    keystroke_trace_start();
+
+    record_tick();
+    for (int i = 0; i < 3; i++) {
+        advance_time(1);
+        record_tick();
+    }
+    advance_time(10);
+    record_key(1, 2, true, 2);
+    advance_time(100);
+    record_tick();
+    keystroke_trace_stop();
+
+    // Ticks after stopping are not recorded
+    advance_time(1);
+    record_tick();
+
+    std::vector<uint8_t> expected = {
+        'Q', 'K', 'T', KEYSTROKE_TRACE_VERSION, 0xE8, 0x03,   // header, starting at 1000ms
+        KEYSTROKE_TRACE_TICKS(0),                             // tick at 1000ms
+        KEYSTROKE_TRACE_TICKS(3),                             // ticks at 1001ms, 1002ms and 1003ms
+        KEYSTROKE_TRACE_TIME(10),                             // 1013ms
+        KEYSTROKE_TRACE_EVENT(KEY_EVENT, true), 1, 2, 2,      // press at 1011ms
+        KEYSTROKE_TRACE_TIME_LONG, 99, 0,                     // 1112ms
+        KEYSTROKE_TRACE_TICKS(1),                             // tick at 1113ms
+    };
+    EXPECT_EQ(drain(), expected);
+}
+
+TEST_F(KeystrokeTrace, SplitsLongTickRuns) {
+    set_time(0);
+    keystroke_trace_start();
+    for (int i = 0; i < KEYSTROKE_TRACE_TICKS_MAX + 2; i++) {
+        advance_time(1);
+        record_tick();
+    }
+    keystroke_trace_stop();
+
+    std::vector<uint8_t> trace = drain();
+    ASSERT_EQ(trace.size(), 8);
+    EXPECT_EQ(trace[6], KEYSTROKE_TRACE_TICKS(KEYSTROKE_TRACE_TICKS_MAX));
+    EXPECT_EQ(trace[7], KEYSTROKE_TRACE_TICKS(2));
+}
+
+TEST_F(KeystrokeTrace, MarksLostRecords) {
+    keystroke_trace_start();
+    drain();
+
+    // Fill the buffer with events, and lose some more
+    for (int i = 0; i < KEYSTROKE_TRACE_BUFFER_SIZE / 4 + 10; i++) {
+        record_key(0, 0, i % 2 == 0);
+    }
+    EXPECT_EQ(keystroke_trace_available(), KEYSTROKE_TRACE_BUFFER_SIZE);
+
+    std::vector<uint8_t> bytes(8);
+    keystroke_trace_read(bytes.data(), bytes.size());
+    record_key(1, 3, true);
+
+    std::vector<uint8_t> tail = drain();
+    ASSERT_GE(tail.size(), 5);
+    std::vector<uint8_t> expected = {KEYSTROKE_TRACE_OVERFLOW, KEYSTROKE_TRACE_EVENT(KEY_EVENT, true), 1, 3, 0};
+    EXPECT_EQ(std::vector<uint8_t>(tail.end() - 5, tail.end()), expected);
+}
+
+TEST_F(KeystrokeTrace, ParsesConsoleLog) {
+    std::istringstream log(
+        "Listening to keyboard\n"
+        "QKT 514B540100\n"
+        "some other output\n"
+        "QKT 0000984A\n");
+    std::vector<uint8_t> expected = {'Q', 'K', 'T', 0x01, 0x00, 0x00, 0x00, 0x98, 0x4A};
+    EXPECT_EQ(parse_keystroke_trace_log(log), expected);
+}
+
+TEST_F(KeystrokeTrace, RejectsOtherData) {
+    KeystrokeTraceReplay replay = replay_keystroke_trace({'Q', 'M', 'K', 1, 0, 0});
+    EXPECT_EQ(replay.error, "not a keystroke trace");
+
+    replay = replay_keystroke_trace({'Q', 'K', 'T', KEYSTROKE_TRACE_VERSION + 1, 0, 0});
+    EXPECT_EQ(replay.error, "unsupported keystroke trace version 2");
+}
+
+TEST_F(KeystrokeTrace, ReplayReproducesSession) {
+    auto key_a     = KeymapKey(0, 0, 0, KC_A);
+    auto mod_tap   = KeymapKey(0, 1, 0, LSFT_T(KC_B));
+    auto key_c     = KeymapKey(0, 2, 0, KC_C);
+    auto layer_tap = KeymapKey(0, 3, 0, LT(1, KC_D));
+    auto layer_a   = KeymapKey(1, 0, 0, KC_E);
+
+    set_keymap({key_a, mod_tap, key_c, layer_tap, layer_a});
+
+    std::vector<std::string> recorded;
+    std::vector<uint8_t>     trace;
+    {
+        testing::NiceMock<TestDriver> driver;
+        capture_keystroke_trace_reports(driver, recorded);
+        keystroke_trace_start();
+
+        tap_key(key_a);
+        idle_for(30);
+
+        /* Mod-tap held past the tapping term */
+        mod_tap.press();
+        idle_for(TAPPING_TERM + 10);
+        tap_key(key_c);
+        mod_tap.release();
+        idle_for(50);
+
+        /* Mod-tap rolled into another key */
+        mod_tap.press();
+        idle_for(20);
+        key_a.press();
+        idle_for(15);
+        mod_tap.release();
+        run_one_scan_loop();
+        key_a.release();
+        idle_for(TAPPING_TERM + 10);
+
+        /* Layer-tap held, then tapped */
+        layer_tap.press();
+        idle_for(TAPPING_TERM + 1);
+        tap_key(key_a);
+        layer_tap.release();
+        idle_for(40);
+        tap_key(layer_tap);
+        idle_for(TAPPING_TERM + 10);
+
+        /* Two keys changing in the same scan */
+        key_a.press();
+        key_c.press();
+        run_one_scan_loop();
+        key_a.release();
+        key_c.release();
+        idle_for(1000);
+
+        keystroke_trace_stop();
+        trace = drain();
+    }
+    ASSERT_FALSE(recorded.empty());
+    ASSERT_EQ(std::count(trace.begin(), trace.end(), KEYSTROKE_TRACE_OVERFLOW), 0);
+
+    KeystrokeTraceReplay replay = replay_keystroke_trace(trace);
+    EXPECT_EQ(replay.error, "");
+    EXPECT_EQ(replay.events, 20);
+    EXPECT_EQ(diff_keystroke_trace_reports(recorded, replay.reports), "");
+    ASSERT_GE(replay.trace.size(), 6);
+    EXPECT_EQ(std::vector<uint8_t>(replay.trace.begin() + 6, replay.trace.end()), std::vector<uint8_t>(trace.begin() + 6, trace.end()));
+}
+
+TEST_F(KeystrokeTrace, ReplayRecordedTrace) {
+    /* A trace recorded from a keyboard, replayed through a keymap with a key in every position */
+    const char* path = std::getenv("QMK_KEYSTROKE_TRACE");
+    if (!path) {
+        GTEST_SKIP() << "Set QMK_KEYSTROKE_TRACE to replay a recorded trace";
+    }
+    std::vector<KeymapKey> keys;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keys.emplace_back(0, col, row, KC_A + (row * MATRIX_COLS + col) % (KC_SLASH - KC_A + 1));
+        }
+    }
+    for (auto& key : keys) {
+        add_key(key);
+    }
+
+    KeystrokeTraceReplay replay = replay_keystroke_trace(load_keystroke_trace(path));
+    EXPECT_EQ(replay.error, "");
+
+    /* The reports of the first replay are kept, and later replays are compared with them */
+    if (const char* reports_path = std::getenv("QMK_KEYSTROKE_TRACE_REPORTS")) {
+        std::ifstream expected_file(reports_path);
+        if (expected_file) {
+            std::vector<std::string> expected;
+            for (std::string line; std::getline(expected_file, line);) {
+                expected.push_back(line);
+            }
+            EXPECT_EQ(diff_keystroke_trace_reports(expected, replay.reports), "");
+        } else {
+            std::ofstream out(reports_path);
+            for (auto& report : replay.reports) {
+                out << report << "\n";
+            }
+        }
+    }
+
+    BenchmarkReport report("keystroke_trace.replay");
+    report.add("events", replay.events);
+    report.add("scans", replay.scans);
+    report.add("reports", replay.reports.size());
+    report.add("simulated_ms", replay.simulated_ms);
+    report.add("wall_us", replay.wall_ns / 1000);
+    report.add("speedup", replay.wall_ns ? (uint64_t)replay.simulated_ms * 1000000 / replay.wall_ns : 0);
+    report.emit();
+}
@@ -0,0 +1,163 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "action_layer.h"
+}
+
+using testing::_;
+
+namespace {
+
+/* The uncached lookup, for comparison */
+uint8_t reference_layer(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if ((layers & ((layer_state_t)1 << i)) && action_for_key(i, key).code != ACTION_TRANSPARENT) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+class LayerResolutionCache : public TestFixture {
+   protected:
+    static constexpr uint8_t layers = 6;
+    static constexpr uint8_t keys   = 4;
+
+    void TearDown() override {
+        layer_clear();
+        default_layer_set(1);
+    }
+
+    /* Every key is opaque on layer 0, and transparent on a varying subset of the layers above */
+    void set_mixed_keymap() {
+        for (uint8_t layer = 0; layer < layers; layer++) {
+            for (uint8_t col = 0; col < keys; col++) {
+                bool transparent = layer > 0 && ((layer + col) % 3 != 0);
+                add_key(KeymapKey(layer, col, 0, transparent ? KC_TRNS : KC_A + layer));
+            }
+        }
+    }
+
+    void expect_matches_reference() {
+        for (uint8_t col = 0; col < keys; col++) {
+            keypos_t key = keypos_t{.col = col, .row = 0};
+            EXPECT_EQ(layer_switch_get_layer(key), reference_layer(key)) << "key " << +col << ", layers " << layer_state;
+        }
+    }
+};
+
+TEST_F(LayerResolutionCache, MatchesUncachedLookup) {
+    TestDriver   driver;
+    std::mt19937 rng(42);
+
+    set_mixed_keymap();
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 500; i++) {
+        // Mostly single layer toggles, as from layer keys, with the occasional wholesale change
+        if (rng() % 4 == 0) {
+            layer_state_set(rng() % (1 << layers));
+        } else {
+            layer_invert(rng() % layers);
+        }
+        expect_matches_reference();
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, DefaultLayerChangesAreTracked) {
+    TestDriver driver;
+
+    set_mixed_keymap();
+    EXPECT_NO_REPORT(driver);
+    for (uint8_t layer = 0; layer < layers; layer++) {
+        default_layer_set((layer_state_t)1 << layer);
+        expect_matches_reference();
+        layer_on(layers - 1);
+        expect_matches_reference();
+        layer_off(layers - 1);
+        expect_matches_reference();
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, DirectlyAssignedLayerStateIsTracked) {
+    TestDriver driver;
+    keypos_t   key = keypos_t{.col = 0, .row = 0};
+
+    set_mixed_keymap();
+    EXPECT_NO_REPORT(driver);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    // Split keyboards assign the layer state received from the other half without calling layer_state_set()
+    layer_state = (layer_state_t)1 << 3;
+    EXPECT_EQ(layer_switch_get_layer(key), 3);
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, KeymapChangesInvalidateCache) {
+    TestDriver driver;
+    keypos_t   key = keypos_t{.col = 0, .row = 0};
+
+    set_keymap({KeymapKey(0, 0, 0, KC_A), KeymapKey(1, 0, 0, KC_TRNS)});
+    layer_on(1);
+    EXPECT_NO_REPORT(driver);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    set_keymap({KeymapKey(0, 0, 0, KC_A), KeymapKey(1, 0, 0, KC_B)});
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerResolutionCache, MomentaryLayerFallsThroughTransparentKeys) {
+    TestDriver driver;
+    auto       key_mo    = KeymapKey(0, 0, 0, MO(1));
+    auto       key_a     = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b     = KeymapKey(0, 2, 0, KC_B);
+    auto       key_mo_l1 = KeymapKey(1, 0, 0, KC_TRNS);
+    auto       key_a_l1  = KeymapKey(1, 1, 0, KC_1);
+    auto       key_b_l1  = KeymapKey(1, 2, 0, KC_TRNS);
+
+    set_keymap({key_mo, key_a, key_b, key_mo_l1, key_a_l1, key_b_l1});
+
+    // Prime the cache with the base layer
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_mo.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_mo.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAPPING_TERM 200
+#define MATRIX_IDLE_TIMEOUT 50
+#define MATRIX_IDLE_POLL_INTERVAL 10
+#define CAPS_WORD_IDLE_TIMEOUT 1000
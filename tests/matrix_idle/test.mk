@@ -0,0 +1,9 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+MATRIX_IDLE_ENABLE = yes
+DEFERRED_EXEC_ENABLE = yes
+COMBO_ENABLE = yes
+CAPS_WORD_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_combos.c
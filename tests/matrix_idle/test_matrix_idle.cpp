@@ -0,0 +1,224 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_matrix.h"
+
+extern "C" {
+#include "matrix_idle.h"
+#include "deferred_exec.h"
+#include "caps_word.h"
+
+void last_matrix_activity_trigger(void);
+
+static uint32_t last_sleep_timeout = 0;
+
+void matrix_idle_sleep(uint32_t timeout_ms) {
+    last_sleep_timeout = timeout_ms;
+}
+
+static uint32_t noop_callback(uint32_t trigger_time, void *cb_arg) {
+    return 0;
+}
+}
+
+using testing::_;
+
+class MatrixIdle : public TestFixture {
+   protected:
+    void SetUp() override {
+        // The timer restarts from zero for every test, so restart the idle timeout along with it
+        last_matrix_activity_trigger();
+        set_matrix_idle_wake_source(true);
+        last_sleep_timeout = 0;
+    }
+
+    void go_idle() {
+        idle_for(MATRIX_IDLE_TIMEOUT + 1);
+        ASSERT_TRUE(matrix_idle_is_idle());
+    }
+};
+
+TEST_F(MatrixIdle, ScanningStopsOnceIdle) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    go_idle();
+    uint32_t scans = matrix_scan_count();
+    idle_for(500);
+    EXPECT_EQ(matrix_scan_count(), scans);
+    EXPECT_TRUE(matrix_idle_is_idle());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, ColumnEdgeWakesOnNextPass) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    go_idle();
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(matrix_idle_is_idle());
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, PollingFallbackWithoutWakeSource) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    set_matrix_idle_wake_source(false);
+    go_idle();
+
+    // Each poll scans once, then idle is re-entered on the following pass
+    uint32_t scans = matrix_scan_count();
+    idle_for(110);
+    EXPECT_EQ(matrix_scan_count() - scans, 110 / (MATRIX_IDLE_POLL_INTERVAL + 1));
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    idle_for(MATRIX_IDLE_POLL_INTERVAL + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, NoTapIsMissedWhilePolling) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    set_matrix_idle_wake_source(false);
+
+    // Taps at least one poll interval long are always seen, whatever their phase relative to the poll
+    for (int phase = 0; phase <= MATRIX_IDLE_POLL_INTERVAL; phase++) {
+        go_idle();
+        idle_for(phase);
+
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        key.press();
+        idle_for(MATRIX_IDLE_POLL_INTERVAL + 1);
+        key.release();
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+    }
+}
+
+TEST_F(MatrixIdle, PendingTapWakesScanningAtTappingTerm) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, LSFT_T(KC_A));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(mod_tap_key);
+    VERIFY_AND_CLEAR(driver);
+
+    // The released tap is still waiting on further taps, but idle is allowed until the tapping term runs out
+    EXPECT_NO_REPORT(driver);
+    go_idle();
+    uint32_t deadline = matrix_idle_next_deadline();
+    EXPECT_GT(deadline, 0);
+    ASSERT_LE(deadline, TAPPING_TERM - MATRIX_IDLE_TIMEOUT);
+
+    uint32_t scans = matrix_scan_count();
+    idle_for(deadline + 1);
+    EXPECT_EQ(matrix_scan_count(), scans + 1);
+    EXPECT_EQ(matrix_idle_next_deadline(), UINT32_MAX);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, SleepsUntilDeferredExecutor) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    go_idle();
+
+    matrix_idle_task();
+    EXPECT_EQ(last_sleep_timeout, UINT32_MAX);
+
+    deferred_token token = defer_exec(300, noop_callback, NULL);
+    EXPECT_EQ(matrix_idle_next_deadline(), 300);
+    idle_for(100);
+    matrix_idle_task();
+    EXPECT_EQ(last_sleep_timeout, 200);
+    cancel_deferred_exec(token);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, SleepIsBoundedByPollInterval) {
+    TestDriver driver;
+
+    set_matrix_idle_wake_source(false);
+    EXPECT_NO_REPORT(driver);
+    go_idle();
+
+    matrix_idle_task();
+    EXPECT_GT(last_sleep_timeout, 0);
+    EXPECT_LE(last_sleep_timeout, MATRIX_IDLE_POLL_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, ComboTermIsReportedAsDeadline) {
+    TestDriver driver;
+    auto       key_j = KeymapKey(0, 0, 0, KC_J);
+    auto       key_k = KeymapKey(0, 1, 0, KC_K);
+
+    set_keymap({key_j, key_k});
+
+    // The combo timer treats a start time of 0 as stopped
+    idle_for(1);
+
+    EXPECT_NO_REPORT(driver);
+    key_j.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    uint32_t deadline = matrix_idle_next_deadline();
+    EXPECT_GT(deadline, 0);
+    ASSERT_LE(deadline, COMBO_TERM + 1);
+
+    EXPECT_REPORT(driver, (KC_J));
+    idle_for(deadline + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_j.release();
+    idle_for(COMBO_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdle, SleepsUntilCapsWordTimeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    caps_word_on();
+    go_idle();
+
+    // Any quantum feature task with a deadline bounds the sleep, not only those listed by the idle code
+    uint32_t deadline = matrix_idle_next_deadline();
+    EXPECT_GT(deadline, 0);
+    EXPECT_LE(deadline, CAPS_WORD_IDLE_TIMEOUT - MATRIX_IDLE_TIMEOUT);
+    matrix_idle_task();
+    EXPECT_EQ(last_sleep_timeout, deadline);
+
+    idle_for(deadline + 1);
+    EXPECT_FALSE(is_caps_word_on());
+    EXPECT_EQ(matrix_idle_next_deadline(), UINT32_MAX);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,158 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <string>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "caps_word.h"
+#include "profiler.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class QuantumTask : public TestFixture {
+   protected:
+    // Drains the profiler on every pass, so that no samples are dropped
+    void run_for(unsigned ms) {
+        for (unsigned i = 0; i < ms; i++) {
+            run_one_scan_loop();
+            profiler_drain();
+        }
+    }
+
+    bool find_zone(const char *name, profiler_zone_stats_t *stats) {
+        for (uint8_t id = 0; id < profiler_zone_count(); id++) {
+            if (profiler_get_zone_stats(id, stats) && std::string(stats->name) == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t caps_word_task_runs() {
+        profiler_zone_stats_t stats;
+        return find_zone("caps_word_task", &stats) ? stats.count : 0;
+    }
+};
+
+TEST_F(QuantumTask, TaskWithNothingPendingIsSkipped) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    run_for(1);
+    profiler_reset();
+    run_for(CAPS_WORD_IDLE_TIMEOUT * 2);
+    EXPECT_EQ(caps_word_task_runs(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(QuantumTask, TaskRunsOnceDeadlineIsDue) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    caps_word_on();
+    run_for(1);
+    profiler_reset();
+
+    run_for(CAPS_WORD_IDLE_TIMEOUT - 1);
+    EXPECT_TRUE(is_caps_word_on());
+    EXPECT_EQ(caps_word_task_runs(), 0);
+
+    run_for(1);
+    EXPECT_FALSE(is_caps_word_on());
+    EXPECT_EQ(caps_word_task_runs(), 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(QuantumTask, KeyEventReschedulesTask) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    caps_word_on();
+    run_for(CAPS_WORD_IDLE_TIMEOUT / 2);
+
+    // Typing restarts the idle timeout, which the task picks up on the next pass
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_a.press();
+    run_for(1);
+    key_a.release();
+    run_for(1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    run_for(CAPS_WORD_IDLE_TIMEOUT - 1);
+    EXPECT_TRUE(is_caps_word_on());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_for(1);
+    EXPECT_FALSE(is_caps_word_on());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(QuantumTask, TaskRuntimeIsNestedUnderQuantumTask) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    caps_word_on();
+    run_for(1);
+
+    profiler_zone_stats_t task, stage;
+    ASSERT_TRUE(find_zone("caps_word_task", &task));
+    ASSERT_TRUE(find_zone("quantum_task", &stage));
+    ASSERT_TRUE(profiler_get_zone_stats(task.parent, &task));
+    EXPECT_STREQ(task.name, stage.name);
+
+    caps_word_off();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(QuantumTask, KeyboardDeadlineFollowsTaskDeadlines) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    run_for(1);
+    EXPECT_GT(keyboard_next_deadline(), CAPS_WORD_IDLE_TIMEOUT);
+
+    // Every task runs on the pass after caps word is turned on, then not until its idle timeout
+    caps_word_on();
+    EXPECT_EQ(keyboard_next_deadline(), 0);
+    run_for(1);
+    EXPECT_EQ(keyboard_next_deadline(), CAPS_WORD_IDLE_TIMEOUT - 1);
+
+    caps_word_off();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(QuantumTask, IdleSkipsPassesBeforeDeadline) {
+    if (std::getenv("QMK_TEST_NO_TIME_WARP")) {
+        GTEST_SKIP() << "Time warp is disabled";
+    }
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    caps_word_on();
+    run_for(1);
+    profiler_reset();
+
+    // Only the first pass, which could have picked up a key press, and the last pass before the deadline are run
+    idle_for(CAPS_WORD_IDLE_TIMEOUT - 1);
+    profiler_drain();
+    profiler_zone_stats_t stage;
+    ASSERT_TRUE(find_zone("quantum_task", &stage));
+    EXPECT_EQ(stage.count, 2);
+    EXPECT_EQ(caps_word_task_runs(), 0);
+    EXPECT_TRUE(is_caps_word_on());
+
+    idle_for(CAPS_WORD_IDLE_TIMEOUT);
+    profiler_drain();
+    EXPECT_FALSE(is_caps_word_on());
+    EXPECT_EQ(caps_word_task_runs(), 1);
+    VERIFY_AND_CLEAR(driver);
+}
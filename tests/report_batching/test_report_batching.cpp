@@ -0,0 +1,150 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == QK_USER_0 && record->event.pressed) {
+        tap_code(KC_B);
+        return false;
+    }
+    return true;
+}
+}
+
+class ReportBatching : public TestFixture {};
+
+TEST_F(ReportBatching, KeysChangingInOneScanAreSentTogether) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, KeysChangingInSeparateScansAreSentSeparately) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, ModifierIsSentBeforeKey) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    auto       key_ctrl  = KeymapKey(0, 1, 0, KC_LEFT_CTRL);
+    auto       key_a     = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({key_shift, key_ctrl, key_a});
+
+    /* Both modifiers in one report, then the key */
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_LEFT_CTRL, KC_A));
+    key_shift.press();
+    key_ctrl.press();
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The modifiers are released first in matrix order, so the key is last to go */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    key_ctrl.release();
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, TapWithinOneScanIsSent) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap = KeymapKey(0, 0, 0, LSFT_T(KC_B));
+
+    set_keymap({mod_tap});
+
+    /* The press is held by tapping until the release, so both are processed in the same scan */
+    EXPECT_NO_REPORT(driver);
+    mod_tap.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportBatching, ReportsOutsideTheActionAreSentInOrder) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a  = KeymapKey(0, 0, 0, KC_A);
+    auto       macro  = KeymapKey(0, 1, 0, QK_USER_0);
+    auto       key_up = KeymapKey(0, 2, 0, KC_AUDIO_VOL_UP);
+
+    set_keymap({key_a, macro, key_up});
+
+    /* The held back press of A goes out before the macro taps B */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    macro.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* and the held back release of A before the consumer report */
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_extra_mock(_));
+    key_a.release();
+    key_up.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_));
+    macro.release();
+    key_up.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,180 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+/**
+ * @brief Reads the host CPU's free-running cycle counter, falling back to
+ * nanoseconds on architectures where no cheap counter is available.
+ */
+static inline uint64_t benchmark_read_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @brief Reads a monotonic wall clock in nanoseconds.
+ */
+static inline uint64_t benchmark_read_ns(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Measures a single interval in both cycles and nanoseconds.
+ */
+class BenchmarkStopwatch {
+   public:
+    BenchmarkStopwatch() {
+        restart();
+    }
+
+    void restart() {
+        m_start_ns     = benchmark_read_ns();
+        m_start_cycles = benchmark_read_cycles();
+    }
+
+    uint64_t elapsed_cycles() const {
+        return benchmark_read_cycles() - m_start_cycles;
+    }
+
+    uint64_t elapsed_ns() const {
+        return benchmark_read_ns() - m_start_ns;
+    }
+
+   private:
+    uint64_t m_start_ns;
+    uint64_t m_start_cycles;
+};
+
+/**
+ * @brief Collects samples for one measured quantity and summarises them.
+ */
+class BenchmarkSeries {
+   public:
+    void add(uint64_t ns, uint64_t cycles) {
+        m_ns.push_back(ns);
+        m_cycles.push_back(cycles);
+    }
+
+    void clear() {
+        m_ns.clear();
+        m_cycles.clear();
+    }
+
+    size_t count() const {
+        return m_ns.size();
+    }
+
+    uint64_t total_ns() const {
+        uint64_t sum = 0;
+        for (auto v : m_ns) sum += v;
+        return sum;
+    }
+
+    uint64_t mean_ns() const {
+        return m_ns.empty() ? 0 : total_ns() / m_ns.size();
+    }
+
+    uint64_t mean_cycles() const {
+        if (m_cycles.empty()) return 0;
+        uint64_t sum = 0;
+        for (auto v : m_cycles) sum += v;
+        return sum / m_cycles.size();
+    }
+
+    uint64_t percentile_ns(unsigned pct) const {
+        return percentile(m_ns, pct);
+    }
+
+    uint64_t percentile_cycles(unsigned pct) const {
+        return percentile(m_cycles, pct);
+    }
+
+    uint64_t max_ns() const {
+        return m_ns.empty() ? 0 : *std::max_element(m_ns.begin(), m_ns.end());
+    }
+
+   private:
+    static uint64_t percentile(std::vector<uint64_t> samples, unsigned pct) {
+        if (samples.empty()) return 0;
+        std::sort(samples.begin(), samples.end());
+        size_t index = (samples.size() - 1) * pct / 100;
+        return samples[index];
+    }
+
+    std::vector<uint64_t> m_ns;
+    std::vector<uint64_t> m_cycles;
+};
+
+/**
+ * @brief Emits one benchmark result in machine-readable form.
+ *
+ * Every result is printed as a single JSON object on a line prefixed with
+ * `[ BENCH    ]`, attached to the current test as gtest properties (so it ends
+ * up in `--gtest_output=xml` / `json` reports), and appended as a JSON line to
+ * the file named by the `QMK_BENCHMARK_OUTPUT` environment variable, if set.
+ */
+class BenchmarkReport {
+   public:
+    explicit BenchmarkReport(std::string name) : m_name(std::move(name)) {}
+
+    BenchmarkReport& add(const std::string& key, uint64_t value) {
+        m_values.emplace_back(key, value);
+        return *this;
+    }
+
+    BenchmarkReport& add_series(const std::string& prefix, const BenchmarkSeries& series) {
+        add(prefix + "_count", series.count());
+        add(prefix + "_ns_mean", series.mean_ns());
+        add(prefix + "_ns_p50", series.percentile_ns(50));
+        add(prefix + "_ns_p99", series.percentile_ns(99));
+        add(prefix + "_ns_max", series.max_ns());
+        add(prefix + "_cycles_mean", series.mean_cycles());
+        add(prefix + "_cycles_p99", series.percentile_cycles(99));
+        return *this;
+    }
+
+    void emit() const {
+        std::stringstream json;
+        json << "{\"benchmark\":\"" << m_name << "\"";
+        for (auto& kv : m_values) {
+            json << ",\"" << kv.first << "\":" << kv.second;
+            testing::Test::RecordProperty(m_name + "." + kv.first, std::to_string(kv.second));
+        }
+        json << "}";
+
+        std::cout << "[ BENCH    ] " << json.str() << std::endl;
+
+        if (const char* path = std::getenv("QMK_BENCHMARK_OUTPUT")) {
+            std::ofstream out(path, std::ios::app);
+            out << json.str() << std::endl;
+        }
+    }
+
+   private:
+    std::string                                   m_name;
+    std::vector<std::pair<std::string, uint64_t>> m_values;
+};
@@ -0,0 +1,218 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "gmock/gmock.h"
+#include "keyboard_report_util.hpp"
+#include "test_driver.hpp"
+
+extern "C" {
+#include "action.h"
+#include "keystroke_trace.h"
+#include "test_matrix.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+/**
+ * @brief Parses the console output of a keyboard recording a keystroke trace.
+ *
+ * Every line containing `QKT <hex>` contributes its bytes, so the log of `qmk console` can be used as it is.
+ */
+inline std::vector<uint8_t> parse_keystroke_trace_log(std::istream& log) {
+    std::vector<uint8_t> trace;
+    std::string          line;
+    while (std::getline(log, line)) {
+        size_t start = line.find("QKT ");
+        if (start == std::string::npos) {
+            continue;
+        }
+        std::string hex = line.substr(start + 4);
+        for (size_t i = 0; i + 1 < hex.size() && isxdigit(hex[i]) && isxdigit(hex[i + 1]); i += 2) {
+            trace.push_back(std::stoi(hex.substr(i, 2), nullptr, 16));
+        }
+    }
+    return trace;
+}
+
+/**
+ * @brief Loads a keystroke trace, either the raw bytes read with keystroke_trace_read(), or a console log.
+ */
+inline std::vector<uint8_t> load_keystroke_trace(const std::string& path) {
+    std::ifstream        file(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() >= 3 && bytes[0] == 'Q' && bytes[1] == 'K' && bytes[2] == 'T') {
+        return bytes;
+    }
+    std::istringstream log(std::string(bytes.begin(), bytes.end()));
+    return parse_keystroke_trace_log(log);
+}
+
+/**
+ * @brief Collects the keyboard reports sent through driver, as "<ms since now> <keys>", so that the reports of a
+ * recorded session can be compared with those of its replay.
+ */
+inline void capture_keystroke_trace_reports(testing::NiceMock<TestDriver>& driver, std::vector<std::string>& reports) {
+    const uint32_t begin = timer_read32();
+    ON_CALL(driver, send_keyboard_mock(testing::_)).WillByDefault([&reports, begin](report_keyboard_t& report) {
+        std::stringstream text;
+        text << report;
+        std::string keys = text.str();
+        keys             = keys.substr(keys.find_first_not_of(' ', keys.find(':') + 1));
+        keys.erase(keys.find_last_not_of('\n') + 1);
+        reports.push_back(std::to_string(timer_read32() - begin) + " " + keys);
+    });
+}
+
+struct KeystrokeTraceReplay {
+    std::vector<std::string> reports;      // keyboard reports, as "<ms since the start> <keys>"
+    std::vector<uint8_t>     trace;        // the trace recorded while replaying
+    uint32_t                 events = 0;   // events replayed
+    uint32_t                 scans  = 0;   // passes of keyboard_task()
+    uint32_t                 simulated_ms = 0;
+    uint64_t                 wall_ns      = 0;
+    std::string              error;        // set when the trace is malformed or incomplete
+};
+
+/**
+ * @brief Replays a keystroke trace through the firmware, starting at the current time.
+ *
+ * Key events are played back through the test matrix, and every tick is a pass of the main loop, so the firmware
+ * sees the same scans as the keyboard did. Other events are passed to action_exec() directly. The trace is recorded
+ * again while replaying, so comparing it with the original shows whether the replay was exact.
+ *
+ * A TestDriver is created for the replay, so none may exist while it runs.
+ */
+inline KeystrokeTraceReplay replay_keystroke_trace(const std::vector<uint8_t>& trace) {
+    KeystrokeTraceReplay            result;
+    testing::NiceMock<TestDriver>   driver;
+    const uint32_t                  begin = timer_read32();
+    auto                            wall  = std::chrono::steady_clock::now();
+
+    capture_keystroke_trace_reports(driver, result.reports);
+
+    if (trace.size() < 6 || trace[0] != 'Q' || trace[1] != 'K' || trace[2] != 'T') {
+        result.error = "not a keystroke trace";
+        return result;
+    }
+    if (trace[3] != KEYSTROKE_TRACE_VERSION) {
+        result.error = "unsupported keystroke trace version " + std::to_string(trace[3]);
+        return result;
+    }
+
+    auto drain = [&]() {
+        uint8_t  chunk[64];
+        uint16_t length;
+        while ((length = keystroke_trace_read(chunk, sizeof(chunk))) > 0) {
+            result.trace.insert(result.trace.end(), chunk, chunk + length);
+        }
+    };
+    auto scan = [&]() {
+        keyboard_task();
+        housekeeping_task();
+        result.scans++;
+        drain();
+    };
+
+    keystroke_trace_start();
+    size_t i = 6;
+    while (i < trace.size()) {
+        uint8_t record = trace[i++];
+        if (record == KEYSTROKE_TRACE_OVERFLOW) {
+            result.error = "records were lost before byte " + std::to_string(i);
+        } else if (KEYSTROKE_TRACE_IS_TICKS(record)) {
+            uint8_t count = record & KEYSTROKE_TRACE_TICKS_MAX;
+            if (count == 0) {
+                scan();
+            }
+            for (; count > 0; count--) {
+                advance_time(1);
+                scan();
+            }
+        } else if (KEYSTROKE_TRACE_IS_TIME(record)) {
+            uint16_t ms = record & 0x3F;
+            if (record == KEYSTROKE_TRACE_TIME_LONG) {
+                if (i + 2 > trace.size()) {
+                    result.error = "truncated record at byte " + std::to_string(i - 1);
+                    break;
+                }
+                ms = trace[i] | (trace[i + 1] << 8);
+                i += 2;
+            }
+            advance_time(ms);
+        } else {
+            if (i + 3 > trace.size()) {
+                result.error = "truncated record at byte " + std::to_string(i - 1);
+                break;
+            }
+            uint8_t row = trace[i], col = trace[i + 1], age = trace[i + 2];
+            i += 3;
+            result.events++;
+
+            if (KEYSTROKE_TRACE_EVENT_TYPE(record) != KEY_EVENT) {
+                action_exec({.key = {.col = col, .row = row}, .time = (uint16_t)(timer_read() - age), .type = (keyevent_type_t)KEYSTROKE_TRACE_EVENT_TYPE(record), .pressed = KEYSTROKE_TRACE_EVENT_PRESSED(record)});
+                drain();
+                continue;
+            }
+
+            // Changes found by the same scan are recorded one after the other in matrix order, so they are replayed
+            // together
+            for (;;) {
+                KEYSTROKE_TRACE_EVENT_PRESSED(record) ? press_key(col, row) : release_key(col, row);
+                if (i + 4 > trace.size() || !KEYSTROKE_TRACE_IS_EVENT(trace[i]) || KEYSTROKE_TRACE_EVENT_TYPE(trace[i]) != KEY_EVENT) {
+                    break;
+                }
+                if (trace[i + 1] < row || (trace[i + 1] == row && trace[i + 2] <= col)) {
+                    break;
+                }
+                record = trace[i];
+                row    = trace[i + 1];
+                col    = trace[i + 2];
+                i += 4;
+                result.events++;
+            }
+            scan();
+        }
+    }
+    keystroke_trace_stop();
+    drain();
+
+    result.simulated_ms = timer_read32() - begin;
+    result.wall_ns      = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wall).count();
+    return result;
+}
+
+/**
+ * @brief Describes where two lists of reports first differ, or returns an empty string if they are the same.
+ */
+inline std::string diff_keystroke_trace_reports(const std::vector<std::string>& expected, const std::vector<std::string>& actual) {
+    size_t first = 0;
+    while (first < expected.size() && first < actual.size() && expected[first] == actual[first]) {
+        first++;
+    }
+    if (first == expected.size() && first == actual.size()) {
+        return "";
+    }
+
+    std::stringstream diff;
+    diff << "reports differ from report " << first << " of " << expected.size() << " expected and " << actual.size() << " replayed:\n";
+    for (size_t i = first > 2 ? first - 2 : 0; i < first; i++) {
+        diff << "  " << expected[i] << "\n";
+    }
+    for (size_t i = first; i < expected.size() && i < first + 5; i++) {
+        diff << "- " << expected[i] << "\n";
+    }
+    for (size_t i = first; i < actual.size() && i < first + 5; i++) {
+        diff << "+ " << actual[i] << "\n";
+    }
+    return diff.str();
+}
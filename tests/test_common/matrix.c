@@ -18,14 +18,45 @@
 #include "test_matrix.h"
 #include <string.h>
 
-static matrix_row_t matrix[MATRIX_ROWS] = {};
+// Simulated switch state, which only becomes visible through matrix_get_row() once the matrix is scanned
+static matrix_row_t switches[MATRIX_ROWS] = {};
+static matrix_row_t matrix[MATRIX_ROWS]   = {};
+static uint32_t     scan_count            = 0;
+
+#ifdef MATRIX_IDLE_ENABLE
+#    include "matrix_idle.h"
+
+// Simulates the column pins raising an edge interrupt on a key press while armed
+static bool idle_wake_source = true;
+static bool idle_wake_armed  = false;
+
+bool matrix_idle_arm(void) {
+    idle_wake_armed = idle_wake_source;
+    return idle_wake_armed;
+}
+
+void matrix_idle_disarm(void) {
+    idle_wake_armed = false;
+}
+
+void set_matrix_idle_wake_source(bool enabled) {
+    idle_wake_source = enabled;
+    // Leave idle, so that the new wake source is used the next time the matrix goes idle
+    if (idle_wake_armed) {
+        matrix_idle_wake();
+    }
+}
+#endif
 
 void matrix_init(void) {
     clear_all_keys();
+    memset(matrix, 0, sizeof(matrix));
     matrix_init_kb();
 }
 
 uint8_t matrix_scan(void) {
+    scan_count++;
+    memcpy(matrix, switches, sizeof(matrix));
     matrix_scan_kb();
     return 1;
 }
@@ -40,12 +71,21 @@ void matrix_init_kb(void) {}
 
 void matrix_scan_kb(void) {}
 
+uint32_t matrix_scan_count(void) {
+    return scan_count;
+}
+
 void press_key(uint8_t col, uint8_t row) {
-    matrix[row] |= (matrix_row_t)1 << col;
+    switches[row] |= (matrix_row_t)1 << col;
+#ifdef MATRIX_IDLE_ENABLE
+    if (idle_wake_armed) {
+        matrix_idle_wake();
+    }
+#endif
 }
 
 void release_key(uint8_t col, uint8_t row) {
-    matrix[row] &= ~((matrix_row_t)1 << col);
+    switches[row] &= ~((matrix_row_t)1 << col);
 }
 
 bool matrix_is_on(uint8_t row, uint8_t col) {
@@ -53,7 +93,7 @@ bool matrix_is_on(uint8_t row, uint8_t col) {
 }
 
 void clear_all_keys(void) {
-    memset(matrix, 0, sizeof(matrix));
+    memset(switches, 0, sizeof(switches));
 }
 
 void led_set(uint8_t usb_led) {}
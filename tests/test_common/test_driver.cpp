@@ -16,7 +16,8 @@
 
 #include "test_driver.hpp"
 
-TestDriver* TestDriver::m_this = nullptr;
+TestDriver* TestDriver::m_this         = nullptr;
+uint32_t    TestDriver::m_sent_reports = 0;
 
 namespace {
 // Given a hex digit between 0 and 15, returns the corresponding keycode.
@@ -46,18 +47,22 @@ uint8_t TestDriver::keyboard_leds(void) {
 
 void TestDriver::send_keyboard(report_keyboard_t* report) {
     test_logger.trace() << *report;
+    m_sent_reports++;
     m_this->send_keyboard_mock(*report);
 }
 
 void TestDriver::send_nkro(report_nkro_t* report) {
+    m_sent_reports++;
     m_this->send_nkro_mock(*report);
 }
 
 void TestDriver::send_mouse(report_mouse_t* report) {
+    m_sent_reports++;
     m_this->send_mouse_mock(*report);
 }
 
 void TestDriver::send_extra(report_extra_t* report) {
+    m_sent_reports++;
     m_this->send_extra_mock(*report);
 }
 
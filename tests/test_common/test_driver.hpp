@@ -36,6 +36,13 @@ class TestDriver {
     MOCK_METHOD1(send_mouse_mock, void(report_mouse_t&));
     MOCK_METHOD1(send_extra_mock, void(report_extra_t&));
 
+    /**
+     * @brief The number of reports of any kind sent to the host so far.
+     */
+    static uint32_t sent_reports() {
+        return m_sent_reports;
+    }
+
    private:
     static uint8_t     keyboard_leds(void);
     static void        send_keyboard(report_keyboard_t* report);
@@ -45,6 +52,7 @@ class TestDriver {
     host_driver_t      m_driver;
     uint8_t            m_leds = 0;
     static TestDriver* m_this;
+    static uint32_t    m_sent_reports;
 };
 
 /**
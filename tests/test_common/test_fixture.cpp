@@ -22,6 +22,7 @@ extern "C" {
 #include "debug.h"
 #include "eeconfig.h"
 #include "keyboard.h"
+#include "keymap_common.h"
 
 void set_time(uint32_t t);
 void advance_time(uint32_t ms);
@@ -56,7 +57,8 @@ void TestFixture::SetUpTestCase() {
 void TestFixture::TearDownTestCase() {}
 
 TestFixture::TestFixture() {
-    m_this = this;
+    m_this      = this;
+    m_time_warp = std::getenv("QMK_TEST_NO_TIME_WARP") == nullptr;
     timer_clear();
     keyrecord_t empty_keyrecord = {0};
     test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &empty_keyrecord) << "ms" << std::endl;
@@ -100,6 +102,12 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE)
+    layer_resolution_cache_invalidate();
+#endif
+#if DECODED_ACTION_CACHE_LAYERS > 0
+    decoded_action_cache_invalidate();
+#endif
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
@@ -127,6 +135,12 @@ void TestFixture::tap_combo(const std::vector<KeymapKey>& chord_keys, unsigned d
 
 void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
     this->keymap.clear();
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_RESOLUTION_CACHE)
+    layer_resolution_cache_invalidate();
+#endif
+#if DECODED_ACTION_CACHE_LAYERS > 0
+    decoded_action_cache_invalidate();
+#endif
     for (auto& key : keys) {
         add_key(key);
     }
@@ -175,10 +189,52 @@ void TestFixture::run_one_scan_loop() {
 void TestFixture::idle_for(unsigned time) {
     test_logger.trace() << +time << " keyboard task " << (time > 1 ? "loops" : "loop") << std::endl;
     for (unsigned i = 0; i < time; i++) {
-        keyboard_task();
-        housekeeping_task();
-        advance_time(1);
+        // The first pass picks up any change to the matrix, and the last checks that the ones before it were not needed
+        unsigned skipped = i > 0 ? time_warp(time - i - 1) : 0;
+        i += skipped;
+        if (skipped == 0) {
+            run_main_loop_pass();
+            continue;
+        }
+
+        // The firmware reported nothing to do until after this pass, so it must not do anything visible
+        const uint32_t      reports = TestDriver::sent_reports();
+        const layer_state_t layers  = layer_state | default_layer_state;
+        const uint32_t      mods    = get_mods() | get_weak_mods() << 8 | get_oneshot_mods() << 16;
+        run_main_loop_pass();
+        if (TestDriver::sent_reports() != reports || (layer_state | default_layer_state) != layers || (get_mods() | get_weak_mods() << 8 | get_oneshot_mods() << 16) != mods) {
+            ADD_FAILURE() << "idle_for() skipped " << skipped << "ms in which keyboard_next_deadline() reported nothing to do, but the firmware then did something at " << timer_read32() - 1 << "ms. A feature needs to report its deadline, or the test can call set_time_warp(false).";
+        }
+    }
+}
+
+void TestFixture::set_time_warp(bool enabled) {
+    m_time_warp = enabled && std::getenv("QMK_TEST_NO_TIME_WARP") == nullptr;
+}
+
+void TestFixture::run_main_loop_pass() {
+    keyboard_task();
+    housekeeping_task();
+    advance_time(1);
+}
+
+/**
+ * @brief Moves the clock on over up to max_ms passes of the main loop in which the firmware has nothing to do.
+ *
+ * @return the number of passes skipped
+ */
+unsigned TestFixture::time_warp(unsigned max_ms) {
+    if (!m_time_warp || max_ms == 0) {
+        return 0;
+    }
+    uint32_t deadline = keyboard_next_deadline();
+    if (deadline <= 1) {
+        return 0;
     }
+    unsigned skipped = std::min<uint32_t>(deadline - 1, max_ms);
+    test_logger.trace() << "time warp over " << skipped << "ms" << std::endl;
+    advance_time(skipped);
+    return skipped;
 }
 
 void TestFixture::print_test_log() const {
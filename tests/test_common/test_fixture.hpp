@@ -61,11 +61,31 @@ class TestFixture : public testing::Test {
     void tap_combo(const std::vector<KeymapKey>& chord_keys, unsigned delay_ms = 1);
 
     void run_one_scan_loop();
+
+    /**
+     * @brief Runs the main loop for `ms` milliseconds.
+     *
+     * With time warp enabled, which is the default, passes in which the firmware has nothing to do, as reported by
+     * keyboard_next_deadline(), are skipped by moving the clock straight on to the last pass before its next deadline,
+     * or the last pass of the idle time. That pass is then expected to do nothing, and the test fails if it sends a
+     * report or changes the layer or mod state, as the deadline was wrong and work may have been skipped.
+     */
     void idle_for(unsigned ms);
 
+    /**
+     * @brief Enables or disables time warp in idle_for(). Setting the `QMK_TEST_NO_TIME_WARP` environment variable
+     * disables it for every test.
+     */
+    void set_time_warp(bool enabled);
+
     void expect_layer_state(layer_t layer) const;
 
    protected:
     void                   print_test_log() const;
     std::vector<KeymapKey> keymap;
+
+   private:
+    void     run_main_loop_pass();
+    unsigned time_warp(unsigned max_ms);
+    bool     m_time_warp;
 };
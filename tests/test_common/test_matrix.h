@@ -24,6 +24,9 @@ void press_key(uint8_t col, uint8_t row);
 void release_key(uint8_t col, uint8_t row);
 void clear_all_keys(void);
 
+uint32_t matrix_scan_count(void);
+void     set_matrix_idle_wake_source(bool enabled);
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,11 +16,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode.h"
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "scan_stage.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -44,6 +46,20 @@ static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+#ifdef KEYBOARD_REPORT_BATCHING
+/* Keyboard reports held back while a scan's events are processed, see host_keyboard_batch_begin() */
+static struct {
+    bool              open;
+    bool              holding;
+    bool              keyboard_pending;
+    bool              nkro_pending;
+    report_keyboard_t keyboard_sent;
+    report_keyboard_t keyboard_held;
+    report_nkro_t     nkro_sent;
+    report_nkro_t     nkro_held;
+} batch;
+#endif
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
 }
@@ -72,7 +88,10 @@ led_t host_keyboard_led_state(void) {
 }
 
 /* send report */
-void host_keyboard_send(report_keyboard_t *report) {
+static void keyboard_send(report_keyboard_t *report) {
+#ifdef KEYBOARD_REPORT_BATCHING
+    memcpy(&batch.keyboard_sent, report, sizeof(report_keyboard_t));
+#endif
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_keyboard(report);
@@ -84,7 +103,9 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
+    SCAN_STAGE_ENTER(SCAN_STAGE_HOST_KEYBOARD_SEND);
     (*driver->send_keyboard)(report);
+    SCAN_STAGE_EXIT(SCAN_STAGE_HOST_KEYBOARD_SEND);
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -95,7 +116,10 @@ void host_keyboard_send(report_keyboard_t *report) {
     }
 }
 
-void host_nkro_send(report_nkro_t *report) {
+static void nkro_send(report_nkro_t *report) {
+#ifdef KEYBOARD_REPORT_BATCHING
+    memcpy(&batch.nkro_sent, report, sizeof(report_nkro_t));
+#endif
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
@@ -109,7 +133,126 @@ void host_nkro_send(report_nkro_t *report) {
     }
 }
 
+#ifdef KEYBOARD_REPORT_BATCHING
+/* Whether the held back report shows the host a state it has to see, before the next report replaces it: a key or
+ * modifier which changes back again, or modifiers changing on one side of a key change, such as a modifier pressed
+ * before a key.
+ */
+static bool batch_must_send_held(uint8_t sent_mods, uint8_t held_mods, uint8_t next_mods, bool keys_before, bool keys_after, bool keys_twice) {
+    uint8_t mods_before = sent_mods ^ held_mods;
+    uint8_t mods_after  = held_mods ^ next_mods;
+    return keys_twice || (mods_before & mods_after) || (mods_before && keys_after) || (keys_before && mods_after);
+}
+
+static bool keyboard_report_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool batch_must_send_held_keyboard(const report_keyboard_t *next) {
+    const report_keyboard_t *reports[] = {&batch.keyboard_sent, &batch.keyboard_held, next};
+    bool                     before = false, after = false, twice = false;
+
+    for (uint8_t r = 0; r < ARRAY_SIZE(reports); r++) {
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            uint8_t key = reports[r]->keys[i];
+            if (key == KC_NO) {
+                continue;
+            }
+            bool sent = keyboard_report_has_key(&batch.keyboard_sent, key);
+            bool held = keyboard_report_has_key(&batch.keyboard_held, key);
+            bool now  = keyboard_report_has_key(next, key);
+            before |= sent != held;
+            after |= held != now;
+            twice |= sent != held && held != now;
+        }
+    }
+    return batch_must_send_held(batch.keyboard_sent.mods, batch.keyboard_held.mods, next->mods, before, after, twice);
+}
+
+#    ifdef NKRO_ENABLE
+static bool batch_must_send_held_nkro(const report_nkro_t *next) {
+    uint8_t before = 0, after = 0, twice = 0;
+
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        uint8_t changed_before = batch.nkro_sent.bits[i] ^ batch.nkro_held.bits[i];
+        uint8_t changed_after  = batch.nkro_held.bits[i] ^ next->bits[i];
+        before |= changed_before;
+        after |= changed_after;
+        twice |= changed_before & changed_after;
+    }
+    return batch_must_send_held(batch.nkro_sent.mods, batch.nkro_held.mods, next->mods, before, after, twice);
+}
+#    endif
+#endif
+
+void host_keyboard_send(report_keyboard_t *report) {
+#ifdef KEYBOARD_REPORT_BATCHING
+    if (batch.holding) {
+        if (batch.keyboard_pending && batch_must_send_held_keyboard(report)) {
+            keyboard_send(&batch.keyboard_held);
+        }
+        memcpy(&batch.keyboard_held, report, sizeof(report_keyboard_t));
+        batch.keyboard_pending = true;
+        return;
+    }
+    host_keyboard_flush();
+#endif
+    keyboard_send(report);
+}
+
+void host_nkro_send(report_nkro_t *report) {
+#ifdef KEYBOARD_REPORT_BATCHING
+    if (batch.holding) {
+#    ifdef NKRO_ENABLE
+        if (batch.nkro_pending && batch_must_send_held_nkro(report)) {
+            nkro_send(&batch.nkro_held);
+        }
+#    endif
+        memcpy(&batch.nkro_held, report, sizeof(report_nkro_t));
+        batch.nkro_pending = true;
+        return;
+    }
+    host_keyboard_flush();
+#endif
+    nkro_send(report);
+}
+
+#ifdef KEYBOARD_REPORT_BATCHING
+void host_keyboard_batch_begin(void) {
+    batch.open = true;
+}
+
+bool host_keyboard_batch_hold(bool hold) {
+    bool was_holding = batch.holding;
+    batch.holding    = batch.open && hold;
+    return was_holding;
+}
+
+void host_keyboard_flush(void) {
+    if (batch.keyboard_pending) {
+        batch.keyboard_pending = false;
+        keyboard_send(&batch.keyboard_held);
+    }
+    if (batch.nkro_pending) {
+        batch.nkro_pending = false;
+        nkro_send(&batch.nkro_held);
+    }
+}
+
+void host_keyboard_batch_end(void) {
+    batch.open    = false;
+    batch.holding = false;
+    host_keyboard_flush();
+}
+#endif
+
 void host_mouse_send(report_mouse_t *report) {
+    host_keyboard_flush();
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_mouse(report);
@@ -131,6 +274,7 @@ void host_mouse_send(report_mouse_t *report) {
 
 void host_system_send(uint16_t usage) {
     if (usage == last_system_usage) return;
+    host_keyboard_flush();
     last_system_usage = usage;
 
     if (!driver) return;
@@ -144,6 +288,7 @@ void host_system_send(uint16_t usage) {
 
 void host_consumer_send(uint16_t usage) {
     if (usage == last_consumer_usage) return;
+    host_keyboard_flush();
     last_consumer_usage = usage;
 
 #ifdef BLUETOOTH_ENABLE
@@ -238,6 +383,7 @@ __attribute__((weak)) void send_digitizer(report_digitizer_t *report) {}
 
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
 void host_programmable_button_send(uint32_t data) {
+    host_keyboard_flush();
     report_programmable_button_t report = {
         .report_id = REPORT_ID_PROGRAMMABLE_BUTTON,
         .usage     = data,
@@ -47,6 +47,29 @@ void    host_programmable_button_send(uint32_t data);
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 
+/* keyboard report batching
+ *
+ * With KEYBOARD_REPORT_BATCHING defined, the keyboard reports sent while a scan's key events are processed are held
+ * back and merged, so that keys changing in the same scan reach the host in one report. A held back report is still
+ * sent on its own when the host needs to see it, such as a modifier pressed before a key, or a key tapped within the
+ * scan. Without it, these do nothing and compile away.
+ */
+#ifdef KEYBOARD_REPORT_BATCHING
+void host_keyboard_batch_begin(void);
+void host_keyboard_batch_end(void);
+/* Allows keyboard reports to be held back, while a batch is open. Returns whether they were before. */
+bool host_keyboard_batch_hold(bool hold);
+/* Sends any held back keyboard report, before waiting for the host to act on it. */
+void host_keyboard_flush(void);
+#else
+static inline void host_keyboard_batch_begin(void) {}
+static inline void host_keyboard_batch_end(void) {}
+static inline bool host_keyboard_batch_hold(bool hold) {
+    return false;
+}
+static inline void host_keyboard_flush(void) {}
+#endif
+
 #ifdef __cplusplus
 }
 #endif